@@ -1,61 +1,101 @@
 #include "main_includes.h"
 
 // Initialization functions
-void initializeStars() {
-    stars.clear();
-    for(int i = 0; i < 300; i++) {
-        Star star;
-        star.x = rand() % 800;
-        star.y = 300 + rand() % 300;
-        star.brightness = 0.5f + (rand() % 50) / 100.0f; // Brighter
-        star.twinkleSpeed = 0.1f + (rand() % 90) / 100.0f;
-        stars.push_back(star);
-    }
+void initializeStars(const ScenarioConfig& config) {
+    // Stars are generated per tile on demand; only the seed is picked here
+    unsigned int seed = config.starSeed ? config.starSeed : (unsigned int)rand();
+    initializeStarfield(starfield, seed);
 }
 
 void initializeClouds() {
     clouds.clear();
-    for(int i = 0; i < 8; i++) {
+    for(int i = 0; i < scenario.cloudCount; i++) {
         Cloud cloud;
-        cloud.x = rand() % 900 - 50;
-        cloud.y = 200 + rand() % 150;
-        cloud.speed = 0.05f + (rand() % 30) / 100.0f;
-        cloud.size = 15 + rand() % 25;
-        cloud.opacity = 0.4f + (rand() % 60) / 100.0f; // More opaque
+        cloud.x = simulationRandom() % 900 - 50;
+        cloud.y = 200 + simulationRandom() % 150;
+        cloud.speed = 0.05f + (simulationRandom() % 30) / 100.0f;
+        cloud.size = 15 + simulationRandom() % 25;
+        cloud.opacity = 0.4f + (simulationRandom() % 60) / 100.0f; // More opaque
         clouds.push_back(cloud);
     }
 }
 
 void initializeSatellites() {
     satellites.clear();
-    for(int i = 0; i < 3; i++) {
+    for(int i = 0; i < scenario.satelliteCount; i++) {
         Satellite sat;
-        sat.x = rand() % 800;
-        sat.y = 400 + rand() % 200;
-        sat.speed = 0.1f + (rand() % 20) / 100.0f;
-        sat.size = 5 + rand() % 10;
-        sat.angle = rand() % 360;
+        sat.x = simulationRandom() % 800;
+        sat.y = 400 + simulationRandom() % 200;
+        sat.speed = 0.1f + (simulationRandom() % 20) / 100.0f;
+        sat.size = 5 + simulationRandom() % 10;
+        sat.angle = simulationRandom() % 360;
         satellites.push_back(sat);
     }
 }
 
+// Next draw of the simulation thread's random stream, in [0, 2^31) like rand()
+int simulationRandom() {
+    return (int)(nextRandom(simulationRandomCounter) >> 1);
+}
+
+// Simulated time, in seconds. Animation that feeds back into the
+// simulation runs on it rather than the wall clock, so restored checkpoints
+// replay the same flight.
+float simulationSeconds() {
+    return simulationTick * (SIMULATION_FRAME_MS * 0.001f);
+}
+
+// Smoke from an emitter of particle_emitters.h at one point
+static void emitSmokeAt(SmokeEmitterId emitter, float x, float y) {
+    EmitterSource source = {x, y, 0.0f, 0.0f};
+    emitSmoke(emitter, &source, 1, smokeParticles, nextParticleId, simulationTick);
+}
+
+// Fill the trail behind the meteor's current position (no allocation)
+static void resetMeteorTrail(Meteor& meteor) {
+    meteor.trailHead = 0;
+    meteor.trailCount = meteorTrailLimit(meteor);
+    for(int j = 0; j < meteor.trailCount; j++) {
+        meteor.trailX[j] = meteor.x - j * 2;
+        meteor.trailY[j] = meteor.y - j * 2;
+    }
+}
+
 void initializeMeteors() {
     meteors.clear();
-    for(int i = 0; i < 2; i++) {
+    for(int i = 0; i < scenario.meteorCount; i++) {
         Meteor meteor;
-        meteor.x = rand() % 800;
-        meteor.y = 500 + rand() % 100;
-        meteor.speed = 0.3f + (rand() % 20) / 100.0f;
-        meteor.size = 3 + rand() % 7;
+        meteor.x = simulationRandom() % 800;
+        meteor.y = 500 + simulationRandom() % 100;
+        meteor.speed = 0.3f + (simulationRandom() % 20) / 100.0f;
+        meteor.size = 3 + simulationRandom() % 7;
         meteor.trailLength = 10;
-        for(int j = 0; j < meteor.trailLength; j++) {
-            meteor.trailX.push_back(meteor.x - j * 2);
-            meteor.trailY.push_back(meteor.y - j * 2);
-        }
+        resetMeteorTrail(meteor);
         meteors.push_back(meteor);
     }
 }
 
+// Start conditions of the loaded scenario (simulation thread state)
+void applyScenario(const ScenarioConfig& config) {
+    rocketX = config.launchPadX;
+    rocketY = LAUNCH_PAD_Y;
+    rocketFuel = config.rocketFuel;
+    rocketStage = config.rocketStage;
+    countdown = config.countdown;
+    targetAltitude = config.targetAltitude;
+    targetVelocity = config.targetVelocity;
+    cameraZoom = config.cameraZoom;
+    cameraX = config.cameraX;
+    cameraY = config.cameraY;
+    cameraTargetZoom = config.cameraZoom;
+    cameraTargetX = config.cameraX;
+    cameraTargetY = config.cameraY;
+    dayTime = config.dayTime;
+    windSpeed = config.windSpeed;
+    windDirection = config.windDirection;
+    simulationStep = config.simulationStep;
+}
+
 void initializeStages() {
     // Initialize stage 1
     stage1.x = rocketX;
@@ -98,155 +138,143 @@ void initializeStages() {
 }
 
 // Update functions
-void updateStars() {
-    for(auto& star : stars) {
-        star.brightness = 0.5f + 0.5f * fabs(sin(glutGet(GLUT_ELAPSED_TIME) * 0.001f * star.twinkleSpeed));
-    }
+
+// ========== PARALLEL UPDATE PASSES ==========
+// Job functions only see what is in UpdatePassData, never the simulation
+// globals directly.
+struct UpdatePassData {
+    std::vector<SmokeParticle>* smoke;
+    std::vector<ExplosionParticle>* explosions;
+    std::vector<Cloud>* clouds;
+    std::vector<Satellite>* satellites;
+    std::vector<Meteor>* meteors;
+    unsigned int* nextParticleId;
+    float windSpeed;
+    float windDirection;
+    unsigned long tick;   // Keys particle randomness
+    float time;           // simulationSeconds(), drives the cloud bob and smoke sway
+    bool spawnEffects;    // visualEffectsEnabled on the simulation thread
+};
+
+static UpdatePassData captureUpdatePassData() {
+    UpdatePassData pass;
+    pass.smoke = &smokeParticles;
+    pass.explosions = &explosionParticles;
+    pass.clouds = &clouds;
+    pass.satellites = &satellites;
+    pass.meteors = &meteors;
+    pass.nextParticleId = &nextParticleId;
+    pass.windSpeed = windSpeed;
+    pass.windDirection = windDirection;
+    pass.tick = simulationTick;
+    pass.time = simulationSeconds();
+    pass.spawnEffects = visualEffectsEnabled;
+    return pass;
 }
 
-void updateClouds() {
-    for(auto& cloud : clouds) {
-        cloud.x += cloud.speed * windSpeed * windDirection;
+// Respawn draws of scenery object 'index', keyed like particle jitter so
+// they do not depend on the worker count
+enum SceneryKind { SCENERY_CLOUD, SCENERY_SATELLITE, SCENERY_METEOR };
+
+static int sceneryRandom(const UpdatePassData& pass, SceneryKind kind, int index, int draw) {
+    unsigned int id = ((unsigned int)kind << 24) | (unsigned int)index;
+    return (int)(keyedRandom(SCENERY_RNG_KEY, id, pass.tick, draw) >> 1);
+}
+
+static void updateCloudsJob(void* data, int begin, int end) {
+    UpdatePassData& pass = *static_cast<UpdatePassData*>(data);
+    for(int i = begin; i < end; i++) {
+        Cloud& cloud = (*pass.clouds)[i];
+        cloud.x += cloud.speed * pass.windSpeed * pass.windDirection;
         if (cloud.x > 850) {
             cloud.x = -50;
-            cloud.y = 200 + rand() % 150;
-            cloud.opacity = 0.4f + (rand() % 60) / 100.0f;
+            cloud.y = 200 + sceneryRandom(pass, SCENERY_CLOUD, i, 0) % 150;
+            cloud.opacity = 0.4f + (sceneryRandom(pass, SCENERY_CLOUD, i, 1) % 60) / 100.0f;
         } else if (cloud.x < -50) {
             cloud.x = 850;
-            cloud.y = 200 + rand() % 150;
-            cloud.opacity = 0.4f + (rand() % 60) / 100.0f;
+            cloud.y = 200 + sceneryRandom(pass, SCENERY_CLOUD, i, 0) % 150;
+            cloud.opacity = 0.4f + (sceneryRandom(pass, SCENERY_CLOUD, i, 1) % 60) / 100.0f;
         }
         
         // Float up and down slightly
-        cloud.y += 0.05f * sin(glutGet(GLUT_ELAPSED_TIME) * 0.001f + cloud.x * 0.01f);
+        cloud.y += 0.05f * sin(pass.time + cloud.x * 0.01f);
     }
 }
 
-void updateSatellites() {
-    for(auto& sat : satellites) {
+static void updateSatellitesJob(void* data, int begin, int end) {
+    UpdatePassData& pass = *static_cast<UpdatePassData*>(data);
+    for(int i = begin; i < end; i++) {
+        Satellite& sat = (*pass.satellites)[i];
         sat.x += sat.speed;
         sat.angle += 1.0f;
         
         if (sat.x > 850) {
             sat.x = -50;
-            sat.y = 400 + rand() % 200;
+            sat.y = 400 + sceneryRandom(pass, SCENERY_SATELLITE, i, 0) % 200;
         }
     }
 }
 
-void updateMeteors() {
-    for(auto& meteor : meteors) {
+static void updateMeteorsJob(void* data, int begin, int end) {
+    UpdatePassData& pass = *static_cast<UpdatePassData*>(data);
+    for(int i = begin; i < end; i++) {
+        Meteor& meteor = (*pass.meteors)[i];
         meteor.x += meteor.speed;
         meteor.y -= meteor.speed * 0.5f;
         
-        // Update trail
-        meteor.trailX.insert(meteor.trailX.begin(), meteor.x);
-        meteor.trailY.insert(meteor.trailY.begin(), meteor.y);
-        if (meteor.trailX.size() > meteor.trailLength) {
-            meteor.trailX.pop_back();
-            meteor.trailY.pop_back();
+        // Update trail: step the head back and overwrite the oldest slot
+        meteor.trailHead = (meteor.trailHead + METEOR_TRAIL_CAPACITY - 1) % METEOR_TRAIL_CAPACITY;
+        meteor.trailX[meteor.trailHead] = meteor.x;
+        meteor.trailY[meteor.trailHead] = meteor.y;
+        if (meteor.trailCount < meteorTrailLimit(meteor)) {
+            meteor.trailCount++;
         }
         
         if (meteor.x > 850 || meteor.y < -50) {
-            meteor.x = rand() % 800;
-            meteor.y = 500 + rand() % 100;
-            meteor.trailX.clear();
-            meteor.trailY.clear();
-            for(int j = 0; j < meteor.trailLength; j++) {
-                meteor.trailX.push_back(meteor.x - j * 2);
-                meteor.trailY.push_back(meteor.y - j * 2);
-            }
+            meteor.x = sceneryRandom(pass, SCENERY_METEOR, i, 0) % 800;
+            meteor.y = 500 + sceneryRandom(pass, SCENERY_METEOR, i, 1) % 100;
+            resetMeteorTrail(meteor);
         }
     }
 }
 
-void updateSmoke() {
-    // Add new smoke particles during launch
-    if (rocketLaunching && rocketFuel > 0 && rocketStage == 1) {
-        // Stage 1 smoke - white/gray
-        for(int i = 0; i < 4; i++) {
-            SmokeParticle smoke;
-            smoke.x = rocketX + (rand() % 40 - 20) * 0.5f;
-            smoke.y = rocketY - 20 - (rand() % 15);
-            smoke.size = 5 + rand() % 10;
-            smoke.speed = 0.1f + (rand() % 10) / 20.0f;
-            smoke.life = 0.8f + (rand() % 30) / 100.0f;
-            smoke.alpha = 0.9f;
-            
-            // White/gray smoke for stage 1
-            float gray = 0.7f + (rand() % 30) / 100.0f;
-            smoke.r = gray;
-            smoke.g = gray;
-            smoke.b = gray;
-            
-            smokeParticles.push_back(smoke);
-        }
-    } 
-    else if (rocketLaunching && rocketFuel > 0 && rocketStage == 2) {
-        // Stage 2 smoke - cleaner, whiter smoke
-        for(int i = 0; i < 2; i++) {
-            SmokeParticle smoke;
-            smoke.x = rocketX + (rand() % 30 - 15) * 0.3f;
-            smoke.y = rocketY - 15 - (rand() % 10);
-            smoke.size = 4 + rand() % 6;
-            smoke.speed = 0.15f + (rand() % 10) / 25.0f;
-            smoke.life = 0.6f + (rand() % 20) / 100.0f;
-            smoke.alpha = 0.8f;
-            
-            // Clean white smoke for stage 2
-            smoke.r = 0.95f;
-            smoke.g = 0.95f;
-            smoke.b = 0.95f;
-            
-            smokeParticles.push_back(smoke);
-        }
-    }
-    else if (rocketLaunching && rocketFuel > 0 && rocketStage == 3) {
-        // Payload smoke - very light, almost invisible
-        if (rand() % 5 == 0) {
-            SmokeParticle smoke;
-            smoke.x = rocketX + (rand() % 20 - 10) * 0.2f;
-            smoke.y = rocketY - 10 - (rand() % 8);
-            smoke.size = 2 + rand() % 4;
-            smoke.speed = 0.2f;
-            smoke.life = 0.4f + (rand() % 10) / 100.0f;
-            smoke.alpha = 0.6f;
-            
-            // Very light smoke for payload
-            smoke.r = 1.0f;
-            smoke.g = 1.0f;
-            smoke.b = 1.0f;
-            
-            smokeParticles.push_back(smoke);
-        }
+static void advanceExplosionJob(void* data, int begin, int end) {
+    UpdatePassData& pass = *static_cast<UpdatePassData*>(data);
+    for(int i = begin; i < end; i++) {
+        ExplosionParticle& particle = (*pass.explosions)[i];
+        particle.x += particle.vx;
+        particle.y += particle.vy;
+        particle.vy -= 0.05f; // Gravity
+        particle.life -= 0.01f;
+        particle.size += 0.1f;
     }
+}
+
+// Dark smoke trailing the young explosion particles
+static void spawnExplosionSmokeJob(void* data, int, int) {
+    UpdatePassData& pass = *static_cast<UpdatePassData*>(data);
+    if (!pass.spawnEffects) return;
     
-    // Add smoke during stage separation explosions
-    for(auto& particle : explosionParticles) {
+    static thread_local std::vector<EmitterSource> sources;
+    sources.clear();
+    for(const auto& particle : *pass.explosions) {
         if (particle.life > 0.5f) {
-            SmokeParticle smoke;
-            smoke.x = particle.x;
-            smoke.y = particle.y;
-            smoke.size = particle.size * 2.0f;
-            smoke.speed = 0.05f;
-            smoke.life = particle.life * 0.8f;
-            smoke.alpha = 0.7f;
-            
-            // Dark smoke for explosions
-            float dark = 0.3f + (rand() % 20) / 100.0f;
-            smoke.r = dark;
-            smoke.g = dark * 0.8f;
-            smoke.b = dark * 0.6f;
-            
-            smokeParticles.push_back(smoke);
+            EmitterSource source = {particle.x, particle.y, particle.size, particle.life};
+            sources.push_back(source);
         }
     }
-    
-    // Update existing smoke particles
-    for(auto& smoke : smokeParticles) {
+    emitSmoke(EMITTER_EXPLOSION_SMOKE, sources.data(), (int)sources.size(),
+              *pass.smoke, *pass.nextParticleId, pass.tick);
+}
+
+static void advanceSmokeJob(void* data, int begin, int end) {
+    UpdatePassData& pass = *static_cast<UpdatePassData*>(data);
+    for(int i = begin; i < end; i++) {
+        SmokeParticle& smoke = (*pass.smoke)[i];
         // Drift upward with some randomness
         smoke.y += smoke.speed;
-        smoke.x += (rand() % 20 - 10) * 0.03f * windDirection;
+        int jitter = (int)(particleRandom(smoke.id, pass.tick, 0) % 20) - 10;
+        smoke.x += jitter * 0.03f * pass.windDirection;
         
         // Slowly fade out
         smoke.life -= 0.005f;
@@ -256,35 +284,108 @@ void updateSmoke() {
         smoke.size += 0.15f;
         
         // Add some organic movement
-        float time = glutGet(GLUT_ELAPSED_TIME) * 0.001f;
-        smoke.x += sin(time * 0.5f + smoke.y * 0.01f) * 0.1f;
-        smoke.y += cos(time * 0.3f + smoke.x * 0.01f) * 0.05f;
+        smoke.x += sin(pass.time * 0.5f + smoke.y * 0.01f) * 0.1f;
+        smoke.y += cos(pass.time * 0.3f + smoke.x * 0.01f) * 0.05f;
     }
-    
-    // Remove dead particles
-    smokeParticles.erase(
-        std::remove_if(smokeParticles.begin(), smokeParticles.end(),
+}
+
+static void removeDeadSmokeJob(void* data, int, int) {
+    std::vector<SmokeParticle>& smoke = *static_cast<UpdatePassData*>(data)->smoke;
+    smoke.erase(
+        std::remove_if(smoke.begin(), smoke.end(),
             [](const SmokeParticle& s) { return s.life <= 0.0f || s.alpha <= 0.0f; }),
-        smokeParticles.end()
+        smoke.end()
     );
 }
 
-void updateExplosion() {
-    for(auto& particle : explosionParticles) {
-        particle.x += particle.vx;
-        particle.y += particle.vy;
-        particle.vy -= 0.05f; // Gravity
-        particle.life -= 0.01f;
-        particle.size += 0.1f;
-    }
-    
-    explosionParticles.erase(
-        std::remove_if(explosionParticles.begin(), explosionParticles.end(),
+static void removeDeadExplosionsJob(void* data, int, int) {
+    std::vector<ExplosionParticle>& explosions = *static_cast<UpdatePassData*>(data)->explosions;
+    explosions.erase(
+        std::remove_if(explosions.begin(), explosions.end(),
             [](const ExplosionParticle& p) { return p.life <= 0.0f; }),
-        explosionParticles.end()
+        explosions.end()
     );
 }
 
+static int smokeCount(void* data) {
+    return (int)static_cast<UpdatePassData*>(data)->smoke->size();
+}
+
+static int explosionCount(void* data) {
+    return (int)static_cast<UpdatePassData*>(data)->explosions->size();
+}
+
+// Clouds, satellites and meteors touch disjoint data: one job each
+void updateScenery() {
+    UpdatePassData pass = captureUpdatePassData();
+    JobId cloudsJob = createJob(updateCloudsJob, &pass, 0, (int)clouds.size());
+    JobId satellitesJob = createJob(updateSatellitesJob, &pass, 0, (int)satellites.size());
+    JobId meteorsJob = createJob(updateMeteorsJob, &pass, 0, (int)meteors.size());
+    JobId done = createJob(0, 0, 0, 0);
+    addJobDependency(done, cloudsJob);
+    addJobDependency(done, satellitesJob);
+    addJobDependency(done, meteorsJob);
+    
+    submitJob(cloudsJob);
+    submitJob(satellitesJob);
+    submitJob(meteorsJob);
+    submitJob(done);
+    waitForJob(done);
+    resetJobs();
+}
+
+static void spawnExhaustSmoke() {
+    // Add new smoke particles during launch (skipped on time-warp sub-steps)
+    if (visualEffectsEnabled && rocketLaunching && rocketFuel > 0 && rocketStage >= 1 && rocketStage <= 3) {
+        emitSmokeAt((SmokeEmitterId)(EMITTER_EXHAUST_STAGE1 + rocketStage - 1), rocketX, rocketY);
+    }
+}
+
+// Explosion and smoke particles. Large particle sets are advanced in
+// parallel ranges of PARTICLE_JOB_GRAIN; their random jitter comes from
+// particleRandom, so the result does not depend on the worker count. The
+// explosion smoke is spawned after the explosion particles have moved and
+// before the smoke advances:
+//
+//   advance explosions -> spawn explosion smoke -> advance smoke -> remove dead smoke
+//                                               -> remove dead explosions
+void updateParticles() {
+    spawnExhaustSmoke();
+    
+    UpdatePassData pass = captureUpdatePassData();
+    if (smokeParticles.size() + explosionParticles.size() < (size_t)PARTICLE_JOB_MIN_COUNT) {
+        // Too few particles to be worth scheduling
+        advanceExplosionJob(&pass, 0, explosionCount(&pass));
+        spawnExplosionSmokeJob(&pass, 0, 0);
+        advanceSmokeJob(&pass, 0, smokeCount(&pass));
+        removeDeadSmokeJob(&pass, 0, 0);
+        removeDeadExplosionsJob(&pass, 0, 0);
+        return;
+    }
+    
+    JobId advanceExplosions = createParallelForJob(advanceExplosionJob, explosionCount, &pass, PARTICLE_JOB_GRAIN);
+    JobId explosionSmoke = createJob(spawnExplosionSmokeJob, &pass, 0, 0);
+    JobId advanceSmoke = createParallelForJob(advanceSmokeJob, smokeCount, &pass, PARTICLE_JOB_GRAIN);
+    JobId removeSmoke = createJob(removeDeadSmokeJob, &pass, 0, 0);
+    JobId removeExplosions = createJob(removeDeadExplosionsJob, &pass, 0, 0);
+    JobId done = createJob(0, 0, 0, 0);
+    addJobDependency(explosionSmoke, advanceExplosions);
+    addJobDependency(advanceSmoke, explosionSmoke);
+    addJobDependency(removeSmoke, advanceSmoke);
+    addJobDependency(removeExplosions, explosionSmoke);
+    addJobDependency(done, removeSmoke);
+    addJobDependency(done, removeExplosions);
+    
+    submitJob(advanceExplosions);
+    submitJob(explosionSmoke);
+    submitJob(advanceSmoke);
+    submitJob(removeSmoke);
+    submitJob(removeExplosions);
+    submitJob(done);
+    waitForJob(done);
+    resetJobs();
+}
+
 void updateRocket() {
     if (rocketExploded) return;
     
@@ -293,192 +394,95 @@ void updateRocket() {
     
     // Update trajectory history
     if (showTrajectory || rocketLaunching) {
-        trajectoryPoints.push_back({rocketX, rocketY});
-        if (trajectoryPoints.size() > 200) {
-            trajectoryPoints.erase(trajectoryPoints.begin());
-        }
+        appendTrajectoryPoint(trajectoryHistory, rocketX, rocketY);
     }
     
-    if (rocketLaunching && rocketFuel > 0) {
-        // Update physics
-        float thrust = 0.0f;
-        
-        // Different thrust for different stages
-        if (rocketStage == 1) {
-            thrust = 0.12f; // Strong thrust for stage 1
-        } else if (rocketStage == 2) {
-            thrust = 0.09f; // Medium thrust for stage 2
-        } else {
-            thrust = 0.06f; // Weak thrust for payload
-        }
-        
-        rocketVelocity += thrust;
-        rocketFuel -= 0.4f; // Fuel consumption
-        
-        // Apply wind effect (less effect at higher altitudes)
-        float windEffect = windSpeed * windDirection * 0.1f * (1.0f - altitude / 1000.0f);
-        rocketX += windEffect;
-        
-        // Slight rotation due to wind
-        rocketAngle += windEffect * 0.5f;
-        
-        // Limit angle
-        if (rocketAngle > 10.0f) rocketAngle = 10.0f;
-        if (rocketAngle < -10.0f) rocketAngle = -10.0f;
-        
-        rocketY += rocketVelocity;
-        
-        // Update telemetry
+    RocketFlightState flight = currentRocketFlightState();
+    FlightStepResult result = stepRocketFlight(flight, currentFlightConditions());
+    storeRocketFlightState(flight);
+    
+    // Update telemetry
+    if (result.events & (FLIGHT_PHASE_POWERED | FLIGHT_PHASE_COASTING | FLIGHT_PHASE_FALLING)) {
         altitude = rocketY - 150.0f;
-        velocity = rocketVelocity;
-        acceleration = thrust * 100; // Convert to m/s²
+    }
+    
+    const RocketFlightState& beforeSeparation = result.preSeparation;
+    
+    if (result.events & FLIGHT_PHASE_POWERED) {
+        velocity = beforeSeparation.velocity;
+        acceleration = result.thrust * 100; // Convert to m/s²
         
         // DEBUG: Print current state for troubleshooting
         static int debugCounter = 0;
         debugCounter++;
-        if (debugCounter >= 30) { // Print every 30 frames
-            std::cout << "DEBUG - Stage: " << rocketStage 
-                      << " | Alt: " << (int)altitude << "m" 
-                      << " | Fuel: " << (int)rocketFuel << "%"
+        if (debugCounter >= 30 && visualEffectsEnabled) { // Print every 30 frames
+            std::cout << "DEBUG - Stage: " << beforeSeparation.stage 
+                      << " | Alt: " << (int)(beforeSeparation.y - 150.0f) << "m" 
+                      << " | Fuel: " << (int)beforeSeparation.fuel << "%"
                       << " | Vel: " << std::fixed << std::setprecision(1) << velocity << "m/s"
-                      << " | Stage1Sep: " << (stage1Separated ? "Y" : "N")
-                      << " | Stage2Sep: " << (stage2Separated ? "Y" : "N") << std::endl;
+                      << " | Stage1Sep: " << (beforeSeparation.stage1Separated ? "Y" : "N")
+                      << " | Stage2Sep: " << (beforeSeparation.stage2Separated ? "Y" : "N") << std::endl;
             debugCounter = 0;
         }
-        
-        // ===== STAGE SEPARATION LOGIC =====
-        // Stage 1 separation conditions
-        if (rocketStage == 1 && !stage1Separated) {
-            bool shouldSeparate = false;
-            std::string reason = "";
-            
-            // Condition 1: Altitude + Fuel + Velocity
-            if (altitude > 250.0f && rocketFuel < 50.0f && velocity > 3.0f) {
-                shouldSeparate = true;
-                reason = "Normal separation (Alt>250m, Fuel<50%, Vel>3m/s)";
-            }
-            // Condition 2: Very low fuel
-            else if (rocketFuel < 10.0f) {
-                shouldSeparate = true;
-                reason = "Emergency separation (Fuel<10%)";
-            }
-            // Condition 3: Very high altitude
-            else if (altitude > 400.0f) {
-                shouldSeparate = true;
-                reason = "Altitude separation (Alt>400m)";
-            }
-            
-            if (shouldSeparate) {
-                std::cout << "\n=== STAGE 1 SEPARATION TRIGGERED ===" << std::endl;
-                std::cout << "Reason: " << reason << std::endl;
-                std::cout << "Current: Alt=" << (int)altitude << "m, Fuel=" << (int)rocketFuel 
-                          << "%, Vel=" << std::fixed << std::setprecision(1) << velocity << "m/s" << std::endl;
-                separateStage(1);
-            }
-        }
-        // Stage 2 separation conditions
-        else if (rocketStage == 2 && !stage2Separated) {
-            bool shouldSeparate = false;
-            std::string reason = "";
-            
-            // Condition 1: Altitude + Fuel + Velocity
-            if (altitude > 500.0f && rocketFuel < 40.0f && velocity > 4.0f) {
-                shouldSeparate = true;
-                reason = "Normal separation (Alt>500m, Fuel<40%, Vel>4m/s)";
-            }
-            // Condition 2: Very low fuel
-            else if (rocketFuel < 15.0f) {
-                shouldSeparate = true;
-                reason = "Emergency separation (Fuel<15%)";
-            }
-            // Condition 3: Very high altitude
-            else if (altitude > 700.0f) {
-                shouldSeparate = true;
-                reason = "Altitude separation (Alt>700m)";
-            }
-            
-            if (shouldSeparate) {
-                std::cout << "\n=== STAGE 2 SEPARATION TRIGGERED ===" << std::endl;
-                std::cout << "Reason: " << reason << std::endl;
-                std::cout << "Current: Alt=" << (int)altitude << "m, Fuel=" << (int)rocketFuel 
-                          << "%, Vel=" << std::fixed << std::setprecision(1) << velocity << "m/s" << std::endl;
-                separateStage(2);
-                currentState = ORBIT;
-            }
+    }
+    
+    // ===== STAGE SEPARATION =====
+    int separatedStage = 0;
+    if (result.events & FLIGHT_EVENT_STAGE1_SEPARATION) separatedStage = 1;
+    if (result.events & FLIGHT_EVENT_STAGE2_SEPARATION) separatedStage = 2;
+    
+    if (separatedStage != 0) {
+        if (result.events & FLIGHT_PHASE_POWERED) {
+            std::cout << "\n=== STAGE " << separatedStage << " SEPARATION TRIGGERED ===" << std::endl;
+            std::cout << "Reason: " << result.separationReason << std::endl;
+            std::cout << "Current: Alt=" << (int)(beforeSeparation.y - 150.0f) << "m, Fuel=" << (int)beforeSeparation.fuel 
+                      << "%, Vel=" << std::fixed << std::setprecision(1) << beforeSeparation.velocity << "m/s" << std::endl;
+        } else {
+            std::cout << "\n=== EMERGENCY: STAGE " << separatedStage << " SEPARATION (OUT OF FUEL) ===" << std::endl;
         }
-        
+        releaseSeparatedStage(separatedStage, beforeSeparation);
+    }
+    
+    if (result.events & FLIGHT_PHASE_POWERED) {
         // Animate flames - different sizes for different stages
-        float time = glutGet(GLUT_ELAPSED_TIME) * 0.001f;
-        if (rocketStage == 1) {
-            flameSize = 40.0f + 15.0f * sin(time * 0.01f);
-        } else if (rocketStage == 2) {
-            flameSize = 25.0f + 8.0f * sin(time * 0.015f);
-        } else {
-            flameSize = 15.0f + 5.0f * sin(time * 0.02f);
+        if (visualEffectsEnabled) {
+            float time = simulationSeconds();
+            if (rocketStage == 1) {
+                flameSize = 40.0f + 15.0f * sin(time * 0.01f);
+            } else if (rocketStage == 2) {
+                flameSize = 25.0f + 8.0f * sin(time * 0.015f);
+            } else {
+                flameSize = 15.0f + 5.0f * sin(time * 0.02f);
+            }
+            flameIntensity = 0.5f + 0.5f * sin(time * 0.02f);
         }
-        flameIntensity = 0.5f + 0.5f * sin(time * 0.02f);
         
         // Random chance of failure (for excitement!)
-        if (rand() % 10000 < 2 && !rocketExploded) { // 0.02% chance per frame
+        if (simulationRandom() % 10000 < 2 && !rocketExploded) { // 0.02% chance per frame
             createExplosion(rocketX, rocketY);
         }
         
         // Check mission success
-        if (rocketY > targetAltitude && rocketVelocity > targetVelocity && !rocketExploded) {
+        const RocketFlightState& powered = result.poweredEnd;
+        if (powered.y > targetAltitude && powered.velocity > targetVelocity && !rocketExploded) {
             missionSuccess = true;
             currentState = MISSION_COMPLETE;
             std::cout << "\n=== MISSION SUCCESS ===" << std::endl;
-            std::cout << "Target altitude reached: " << (int)altitude << "m" << std::endl;
+            std::cout << "Target altitude reached: " << (int)(powered.y - 150.0f) << "m" << std::endl;
             std::cout << "Target velocity reached: " << std::fixed << std::setprecision(1) << velocity << "m/s" << std::endl;
         }
-        
-        if (rocketY > 1000) {
-            rocketLaunched = true;
-            rocketLaunching = false;
-            std::cout << "\n=== MAXIMUM ALTITUDE REACHED ===" << std::endl;
-        }
     }
-    else if (rocketLaunching && rocketFuel <= 0) {
-        // Out of fuel but still launching (coasting)
-        rocketVelocity -= 0.02f; // Reduced gravity at high altitude
-        rocketY += rocketVelocity;
-        
-        // Update telemetry
-        altitude = rocketY - 150.0f;
-        
-        // Emergency separation if out of fuel
-        if (rocketStage == 1 && !stage1Separated && altitude > 200.0f) {
-            std::cout << "\n=== EMERGENCY: STAGE 1 SEPARATION (OUT OF FUEL) ===" << std::endl;
-            separateStage(1);
-        }
-        else if (rocketStage == 2 && !stage2Separated && altitude > 450.0f) {
-            std::cout << "\n=== EMERGENCY: STAGE 2 SEPARATION (OUT OF FUEL) ===" << std::endl;
-            separateStage(2);
-            currentState = ORBIT;
-        }
+    
+    if (result.events & FLIGHT_EVENT_MAX_ALTITUDE) {
+        std::cout << "\n=== MAXIMUM ALTITUDE REACHED ===" << std::endl;
     }
     
-    // Apply gravity if not launching (falling back)
-    if (!rocketLaunching && rocketY > 150.0f && !rocketExploded) {
-        rocketVelocity -= 0.05f; // Gravity
-        rocketY += rocketVelocity;
-        
-        // Update altitude even when falling
-        altitude = rocketY - 150.0f;
-        
-        // Crash detection
-        if (rocketY <= 150.0f && rocketVelocity < -2.0f) {
-            createExplosion(rocketX, rocketY);
-            std::cout << "\n=== ROCKET CRASHED ===" << std::endl;
-        }
-        else if (rocketY <= 150.0f) {
-            // Soft landing
-            rocketY = 150.0f;
-            rocketVelocity = 0.0f;
-            rocketLaunching = false;
-            rocketLaunched = false;
-            std::cout << "\n=== ROCKET LANDED ===" << std::endl;
-        }
+    if ((result.events & FLIGHT_EVENT_CRASHED) && !rocketExploded) {
+        createExplosion(rocketX, rocketY);
+        std::cout << "\n=== ROCKET CRASHED ===" << std::endl;
+    }
+    else if (result.events & FLIGHT_EVENT_LANDED) {
+        std::cout << "\n=== ROCKET LANDED ===" << std::endl;
     }
     
     // Update stage positions relative to rocket
@@ -512,7 +516,7 @@ void updateCamera() {
     // Set camera targets based on mode
     switch(currentCameraMode) {
         case MODE_LAUNCH_PAD:
-            cameraTargetX = LAUNCH_PAD_X;
+            cameraTargetX = scenario.launchPadX;
             cameraTargetY = LAUNCH_PAD_Y + 150;
             cameraTargetZoom = 1.0f;
             break;
@@ -599,8 +603,8 @@ void updateCamera() {
     
     // Camera shake effect
     if (cameraShake && shakeIntensity > 0.0f) {
-        cameraX += (rand() % 100 - 50) * 0.01f * shakeIntensity;
-        cameraY += (rand() % 100 - 50) * 0.01f * shakeIntensity;
+        cameraX += (simulationRandom() % 100 - 50) * 0.01f * shakeIntensity;
+        cameraY += (simulationRandom() % 100 - 50) * 0.01f * shakeIntensity;
         shakeIntensity *= 0.9f;
         if (shakeIntensity < 0.01f) {
             cameraShake = false;
@@ -616,41 +620,36 @@ void updateDayNight() {
     }
 }
 
+// Ground for stage crashes. The render thread streams 'terrain' as it
+// draws, so the simulation has a table of its own; nothing is ever loaded
+// into it, and terrainHeight evaluates the same samples on the fly.
+static Terrain collisionTerrain;
+
 void updateSeparatedStages() {
+    float dt = simulationStep;
+    float time = simulationSeconds();
+    
     // Update stage 1 if separated
     if (stage1Separated && stage1Falling && stage1.falling) {
-        // Stage 1 should fall DOWN (negative Y direction)
-        stage1.velocity -= 0.08f; // Stronger gravity for stage 1
-        stage1.y += stage1.velocity;
+        // Stage 1 should fall DOWN (negative Y direction) with stronger gravity.
+        // The parachute deploys at a certain altitude and slows descent more
+        // (keeps 97% of the velocity per tick below 400 while faster than -1.5)
+        MotionState motion = {stage1.y, stage1.velocity};
+        integrateMotion(motion, acceleratedWithDrag(-0.08f, 0.97f, 400.0f, -1.5f), dt, currentIntegrator);
+        stage1.y = motion.position;
+        stage1.velocity = motion.velocity;
         
         // Add some horizontal drift - make it visible
-        stage1.x += (windSpeed * windDirection * 2.0f) + (sin(glutGet(GLUT_ELAPSED_TIME) * 0.001f) * 0.5f);
+        stage1.x += ((windSpeed * windDirection * 2.0f) + (sin(time) * 0.5f)) * dt;
         
         // Add rotation while falling - make it spin
-        stage1.angle += 5.0f + sin(glutGet(GLUT_ELAPSED_TIME) * 0.002f) * 2.0f;
-        
-        // Deploy parachute at certain altitude
-        if (stage1.y < 400 && stage1.velocity < -1.5f) {
-            stage1.velocity *= 0.97f; // Parachute slows descent more
-        }
+        stage1.angle += (5.0f + sin(time * 2.0f) * 2.0f) * dt;
         
         // Add smoke trail from falling stage - make it more visible
-        if (rand() % 5 == 0) {
-            SmokeParticle smoke;
-            smoke.x = stage1.x + (rand() % 20 - 10);
-            smoke.y = stage1.y + (rand() % 20 - 10);
-            smoke.size = 3 + rand() % 6;
-            smoke.speed = 0.2f;
-            smoke.life = 0.5f;
-            smoke.alpha = 0.6f;
-            smoke.r = 0.6f;
-            smoke.g = 0.6f;
-            smoke.b = 0.6f;
-            smokeParticles.push_back(smoke);
-        }
+        if (visualEffectsEnabled) emitSmokeAt(EMITTER_TRAIL_STAGE1, stage1.x, stage1.y);
         
         // Check if hit ground
-        if (stage1.y <= 150.0f) {
+        if (stage1.y <= terrainHeight(collisionTerrain, stage1.x)) {
             stage1Falling = false;
             stage1.falling = false;
             createExplosion(stage1.x, stage1.y);
@@ -660,33 +659,23 @@ void updateSeparatedStages() {
     
     // Update stage 2 if separated
     if (stage2Separated && stage2Falling && stage2.falling) {
-        // Stage 2 should also fall DOWN
-        stage2.velocity -= 0.07f; // Slightly less gravity
-        stage2.y += stage2.velocity;
+        // Stage 2 should also fall DOWN (slightly less gravity)
+        MotionState motion = {stage2.y, stage2.velocity};
+        integrateMotion(motion, constantAcceleration(-0.07f), dt, currentIntegrator);
+        stage2.y = motion.position;
+        stage2.velocity = motion.velocity;
         
         // Add some horizontal drift
-        stage2.x += (windSpeed * windDirection * 1.5f) + (cos(glutGet(GLUT_ELAPSED_TIME) * 0.001f) * 0.3f);
+        stage2.x += ((windSpeed * windDirection * 1.5f) + (cos(time) * 0.3f)) * dt;
         
         // Add rotation while falling
-        stage2.angle += 6.0f + cos(glutGet(GLUT_ELAPSED_TIME) * 0.003f) * 3.0f;
+        stage2.angle += (6.0f + cos(time * 3.0f) * 3.0f) * dt;
         
         // Add smoke trail
-        if (rand() % 8 == 0) {
-            SmokeParticle smoke;
-            smoke.x = stage2.x + (rand() % 15 - 7);
-            smoke.y = stage2.y + (rand() % 15 - 7);
-            smoke.size = 2 + rand() % 4;
-            smoke.speed = 0.15f;
-            smoke.life = 0.4f;
-            smoke.alpha = 0.5f;
-            smoke.r = 0.7f;
-            smoke.g = 0.7f;
-            smoke.b = 0.7f;
-            smokeParticles.push_back(smoke);
-        }
+        if (visualEffectsEnabled) emitSmokeAt(EMITTER_TRAIL_STAGE2, stage2.x, stage2.y);
         
         // Check if hit ground
-        if (stage2.y <= 150.0f) {
+        if (stage2.y <= terrainHeight(collisionTerrain, stage2.x)) {
             stage2Falling = false;
             stage2.falling = false;
             createExplosion(stage2.x, stage2.y);
@@ -698,18 +687,19 @@ void updateSeparatedStages() {
 // Special effects
 void createExplosion(float x, float y) {
     rocketExploded = true;
+    flightEventCount++; // Time warp stops on explosions
     
     for(int i = 0; i < 100; i++) {
         ExplosionParticle particle;
         particle.x = x;
         particle.y = y;
-        particle.vx = (rand() % 200 - 100) / 10.0f;
-        particle.vy = (rand() % 200 - 100) / 10.0f;
-        particle.size = 2 + rand() % 8;
+        particle.vx = (simulationRandom() % 200 - 100) / 10.0f;
+        particle.vy = (simulationRandom() % 200 - 100) / 10.0f;
+        particle.size = 2 + simulationRandom() % 8;
         particle.life = 1.0f;
         
         // Color based on explosion type
-        float colorRand = rand() % 100 / 100.0f;
+        float colorRand = simulationRandom() % 100 / 100.0f;
         if (colorRand < 0.3f) {
             particle.r = 1.0f; particle.g = 0.6f; particle.b = 0.0f; // Brighter orange
         } else if (colorRand < 0.6f) {
@@ -726,40 +716,17 @@ void createExplosion(float x, float y) {
 
 
 void createStageSeparationEffect(float x, float y, int stageNum) {
-    // Create separation smoke/particles
-    for(int i = 0; i < 30; i++) {
-        SmokeParticle debris;
-        debris.x = x + (rand() % 60 - 30);
-        debris.y = y + (rand() % 60 - 30);
-        debris.size = 2 + rand() % 6;
-        debris.speed = 0.05f + (rand() % 15) / 30.0f;
-        debris.life = 0.6f + (rand() % 40) / 100.0f;
-        debris.alpha = 0.9f;
-        
-        // Different smoke colors for different stages
-        if (stageNum == 1) {
-            // Orange/brown smoke for stage 1 separation
-            debris.r = 0.8f + (rand() % 20) / 100.0f;
-            debris.g = 0.4f + (rand() % 30) / 100.0f;
-            debris.b = 0.2f + (rand() % 20) / 100.0f;
-        } else {
-            // Blue/gray smoke for stage 2 separation
-            debris.r = 0.6f + (rand() % 20) / 100.0f;
-            debris.g = 0.7f + (rand() % 20) / 100.0f;
-            debris.b = 0.9f + (rand() % 10) / 100.0f;
-        }
-        
-        smokeParticles.push_back(debris);
-    }
+    // Separation smoke, orange/brown for stage 1 and blue/gray for stage 2
+    emitSmokeAt(stageNum == 1 ? EMITTER_SEPARATION_STAGE1 : EMITTER_SEPARATION_STAGE2, x, y);
     
     // Also add explosion particles for more dramatic effect
     for(int i = 0; i < 15; i++) {
         ExplosionParticle particle;
         particle.x = x;
         particle.y = y;
-        particle.vx = (rand() % 200 - 100) / 25.0f;
-        particle.vy = (rand() % 200 - 100) / 25.0f;
-        particle.size = 1 + rand() % 3;
+        particle.vx = (simulationRandom() % 200 - 100) / 25.0f;
+        particle.vy = (simulationRandom() % 200 - 100) / 25.0f;
+        particle.size = 1 + simulationRandom() % 3;
         particle.life = 0.9f;
         
         if (stageNum == 1) {
@@ -775,25 +742,70 @@ void createStageSeparationEffect(float x, float y, int stageNum) {
 }
 
 
+// ========== FLIGHT STATE ==========
+RocketFlightState currentRocketFlightState() {
+    RocketFlightState state;
+    state.x = rocketX;
+    state.y = rocketY;
+    state.velocity = rocketVelocity;
+    state.angle = rocketAngle;
+    state.fuel = rocketFuel;
+    state.stage = rocketStage;
+    state.launching = rocketLaunching;
+    state.launched = rocketLaunched;
+    state.stage1Separated = stage1Separated;
+    state.stage2Separated = stage2Separated;
+    return state;
+}
+
+void storeRocketFlightState(const RocketFlightState& state) {
+    rocketX = state.x;
+    rocketY = state.y;
+    rocketVelocity = state.velocity;
+    rocketAngle = state.angle;
+    rocketFuel = state.fuel;
+    rocketStage = state.stage;
+    rocketLaunching = state.launching;
+    rocketLaunched = state.launched;
+    stage1Separated = state.stage1Separated;
+    stage2Separated = state.stage2Separated;
+}
+
+FlightConditions currentFlightConditions() {
+    FlightConditions conditions;
+    conditions.windSpeed = windSpeed;
+    conditions.windDirection = windDirection;
+    conditions.step = simulationStep;
+    conditions.integrator = currentIntegrator;
+    return conditions;
+}
+
 void separateStage(int stageNum) {
-    if (stageNum == 1 && !stage1Separated) {
-        stage1Separated = true;
+    RocketFlightState flight = currentRocketFlightState();
+    RocketFlightState beforeSeparation = flight;
+    if (!applyStageSeparation(flight, stageNum)) return;
+    
+    storeRocketFlightState(flight);
+    releaseSeparatedStage(stageNum, beforeSeparation);
+}
+
+// Spawn the detached stage and its effects once the flight state has already
+// switched to the next stage. 'before' is the rocket just before separating.
+void releaseSeparatedStage(int stageNum, const RocketFlightState& before) {
+    flightEventCount++; // Time warp stops on separations
+    
+    if (stageNum == 1) {
         stage1Falling = true;
         stage1.falling = true;
-        stage1.x = rocketX;
-        stage1.y = rocketY;
-        stage1.velocity = rocketVelocity * 0.7f; // Keep some momentum
-        stage1.angle = rocketAngle + (rand() % 20 - 10); // Random tilt
-        createStageSeparationEffect(rocketX, rocketY, 1);
+        stage1.x = before.x;
+        stage1.y = before.y;
+        stage1.velocity = before.velocity * 0.7f; // Keep some momentum
+        stage1.angle = before.angle + (simulationRandom() % 20 - 10); // Random tilt
+        createStageSeparationEffect(before.x, before.y, 1);
         
         // Stage 2 becomes active
-        rocketStage = 2;
-        rocketFuel = 100.0f; // Full fuel for stage 2
         flameSize = 25.0f; // Medium flame for stage 2
         
-        // Small velocity loss during separation (realistic)
-        rocketVelocity *= 0.95f;
-        
         // Update stage 2 position
         stage2.active = true;
         stage2.x = rocketX;
@@ -811,7 +823,7 @@ void separateStage(int stageNum) {
             std::cout << "Camera: Following Stage 1 (falling)" << std::endl;
             
             // Set timer to switch camera back to rocket after 3 seconds
-            glutTimerFunc(3000, [](int value) {
+            scheduleSimulationCallback(3000, [](int value) {
                 if (!rocketExploded && currentCameraMode == MODE_FOLLOW_STAGE1) {
                     currentCameraMode = MODE_FOLLOW_ROCKET;
                     // ZOOM IN when switching to stage 2
@@ -823,24 +835,18 @@ void separateStage(int stageNum) {
             }, 0);
         }
     }
-    else if (stageNum == 2 && !stage2Separated) {
-        stage2Separated = true;
+    else if (stageNum == 2) {
         stage2Falling = true;
         stage2.falling = true;
-        stage2.x = rocketX;
-        stage2.y = rocketY;
-        stage2.velocity = rocketVelocity * 0.7f; // Keep some momentum
-        stage2.angle = rocketAngle + (rand() % 20 - 10); // Random tilt
-        createStageSeparationEffect(rocketX, rocketY, 2);
+        stage2.x = before.x;
+        stage2.y = before.y;
+        stage2.velocity = before.velocity * 0.7f; // Keep some momentum
+        stage2.angle = before.angle + (simulationRandom() % 20 - 10); // Random tilt
+        createStageSeparationEffect(before.x, before.y, 2);
         
         // IMPORTANT: Move to PAYLOAD (Stage 3)
-        rocketStage = 3;
-        rocketFuel = 50.0f; // Limited fuel for payload
         flameSize = 15.0f; // Small PURPLE flame for payload
         
-        // Very small velocity loss for payload separation
-        rocketVelocity *= 0.98f;
-        
         // IMPORTANT: Payload continues from the SAME position
         // (rocketX, rocketY) stays the same - only the stage number changes
         
@@ -864,7 +870,7 @@ void separateStage(int stageNum) {
             std::cout << "Camera: Following Stage 2 (falling)" << std::endl;
             
             // Set timer to switch camera back to PAYLOAD after 3 seconds
-            glutTimerFunc(3000, [](int value) {
+            scheduleSimulationCallback(3000, [](int value) {
                 if (!rocketExploded && currentCameraMode == MODE_FOLLOW_STAGE2) {
                     currentCameraMode = MODE_FOLLOW_ROCKET;
                     // IMPORTANT: ZOOM IN CLOSER for payload
@@ -920,3 +926,47 @@ void switchCameraToRocket(int value) {
         std::cout << "Auto-switching camera back to rocket view" << std::endl;
     }
 }
+
+// Time until 'current' reaches 'target' under constant acceleration from 'rate'
+static float ticksToReach(float current, float rate, float accel, float target) {
+    float distance = target - current;
+    if (distance <= 0.0f) return 0.0f;
+    if (accel > 0.0f) {
+        return (-rate + sqrt(rate * rate + 2.0f * accel * distance)) / accel;
+    }
+    if (rate > 0.0f) return distance / rate;
+    return 1e9f;
+}
+
+// Rough estimate of ticks until the next automatic stage separation,
+// used by time warp to drop back to 1x before the event
+float ticksUntilSeparation() {
+    const float never = 1e9f;
+    if (!rocketLaunching || rocketExploded || rocketStage >= 3) return never;
+    
+    if (rocketStage == 1 ? stage1Separated : stage2Separated) return never;
+    const StageSeparationRule& rule = STAGE_SEPARATION_RULES[rocketStage - 1];
+    float thrust = STAGE_THRUST[rocketStage - 1];
+    
+    // Coasting: emergency separation once above the coast altitude
+    if (rocketFuel <= 0.0f) {
+        return ticksToReach(altitude, rocketVelocity, COAST_ACCELERATION, rule.coastAltitude);
+    }
+    
+    float normal = std::max(ticksToReach(altitude, rocketVelocity, thrust, rule.normalAltitude),
+                   std::max((rocketFuel - rule.normalFuel) / FUEL_BURN_RATE,
+                            ticksToReach(rocketVelocity, thrust, 0.0f, rule.normalVelocity)));
+    float emergency = (rocketFuel - rule.emergencyFuel) / FUEL_BURN_RATE;
+    float highAltitude = ticksToReach(altitude, rocketVelocity, thrust, rule.maxAltitude);
+    
+    return std::max(0.0f, std::min(normal, std::min(emergency, highAltitude)));
+}
+
+void setTimeWarpLevel(int level) {
+    if (level < 0) level = 0;
+    if (level >= TIME_WARP_LEVEL_COUNT) level = TIME_WARP_LEVEL_COUNT - 1;
+    if (level != timeWarpLevel) {
+        timeWarpLevel = level;
+        std::cout << "Time warp: " << TIME_WARP_LEVELS[timeWarpLevel] << "x" << std::endl;
+    }
+}
@@ -0,0 +1,123 @@
+// raster_sink_bench.cpp
+// FramebufferSink against a hand-written loop doing the same work: the
+// same Bresenham stepping and the same per-pixel bounds check, straight
+// into the pixel array. The sink should cost nothing on top of it.
+// Then anti-aliased (Wu) lines against aliased ones through the same sink,
+// both clipped by the float entry points: AA should cost under 2x.
+#include "framebuffer.h"
+#include "rasterizer.h"
+#include "rasterizer_aa.h"
+#include "raster_sinks.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static const int BENCH_WIDTH = 1024;
+static const int BENCH_HEIGHT = 768;
+static const int BENCH_LINES = 20000;
+static const int BENCH_TRIALS = 15;
+
+struct BenchLine {
+    int x1, y1, x2, y2;
+};
+
+static inline void plot(Framebuffer& framebuffer, int x, int y, unsigned int color) {
+    if ((unsigned)x < (unsigned)framebuffer.width && (unsigned)y < (unsigned)framebuffer.height) {
+        framebuffer.pixels[(size_t)y * framebuffer.width + x] = color;
+    }
+}
+
+static void handWrittenLine(Framebuffer& framebuffer, int x1, int y1, int x2, int y2, unsigned int color) {
+    bool xMajor = std::abs(x2 - x1) >= std::abs(y2 - y1);
+    if (xMajor ? x2 < x1 : y2 < y1) {
+        std::swap(x1, x2);
+        std::swap(y1, y2);
+    }
+    int dMajor = xMajor ? x2 - x1 : y2 - y1;
+    int dMinor = xMajor ? std::abs(y2 - y1) : std::abs(x2 - x1);
+    int stepMinor = (xMajor ? y2 >= y1 : x2 >= x1) ? 1 : -1;
+    int major = xMajor ? x1 : y1;
+    int minor = xMajor ? y1 : x1;
+    int error = 2 * dMinor - dMajor;
+    if (xMajor) {
+        for (int i = 0; i <= dMajor; i++) {
+            plot(framebuffer, major + i, minor, color);
+            bool carry = error > 0;
+            minor += carry ? stepMinor : 0;
+            error += 2 * dMinor + (carry ? -2 * dMajor : 0);
+        }
+    } else {
+        for (int i = 0; i <= dMajor; i++) {
+            plot(framebuffer, minor, major + i, color);
+            bool carry = error > 0;
+            minor += carry ? stepMinor : 0;
+            error += 2 * dMinor + (carry ? -2 * dMajor : 0);
+        }
+    }
+}
+
+template <typename Draw>
+static double bestMilliseconds(Framebuffer& framebuffer, Draw draw) {
+    double best = 1e30;
+    for (int trial = 0; trial < BENCH_TRIALS; trial++) {
+        std::fill(framebuffer.pixels.begin(), framebuffer.pixels.end(), 0u);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        draw();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() < best) best = elapsed.count();
+    }
+    return best;
+}
+
+int main() {
+    // Lines reaching up to a quarter screen past every edge
+    std::vector<BenchLine> lines(BENCH_LINES);
+    srand(12345);
+    for (size_t i = 0; i < lines.size(); i++) {
+        lines[i].x1 = rand() % (BENCH_WIDTH * 3 / 2) - BENCH_WIDTH / 4;
+        lines[i].y1 = rand() % (BENCH_HEIGHT * 3 / 2) - BENCH_HEIGHT / 4;
+        lines[i].x2 = rand() % (BENCH_WIDTH * 3 / 2) - BENCH_WIDTH / 4;
+        lines[i].y2 = rand() % (BENCH_HEIGHT * 3 / 2) - BENCH_HEIGHT / 4;
+    }
+    const unsigned int color = 0xFF40C0FFu;
+
+    Framebuffer viaSink;
+    Framebuffer viaLoop;
+    resizeFramebuffer(viaSink, BENCH_WIDTH, BENCH_HEIGHT);
+    resizeFramebuffer(viaLoop, BENCH_WIDTH, BENCH_HEIGHT);
+
+    double sinkTime = bestMilliseconds(viaSink, [&]() {
+        FramebufferSink sink(viaSink, color);
+        for (size_t i = 0; i < lines.size(); i++) {
+            rasterLineBresenham(sink, lines[i].x1, lines[i].y1, lines[i].x2, lines[i].y2);
+        }
+    });
+    double loopTime = bestMilliseconds(viaLoop, [&]() {
+        for (size_t i = 0; i < lines.size(); i++) {
+            handWrittenLine(viaLoop, lines[i].x1, lines[i].y1, lines[i].x2, lines[i].y2, color);
+        }
+    });
+
+    bool same = viaSink.pixels == viaLoop.pixels;
+    printf("%d Bresenham lines into %dx%d (best of %d)\n", BENCH_LINES, BENCH_WIDTH, BENCH_HEIGHT, BENCH_TRIALS);
+    printf("  FramebufferSink  %8.2f ms\n", sinkTime);
+    printf("  hand-written     %8.2f ms  (sink / loop %.2f)\n", loopTime, sinkTime / loopTime);
+    printf("  pixels %s\n", same ? "identical" : "DIFFER");
+
+    double aliasedTime = bestMilliseconds(viaSink, [&]() {
+        FramebufferSink sink(viaSink, color);
+        for (size_t i = 0; i < lines.size(); i++) {
+            rasterLineBresenham(sink, (float)lines[i].x1, (float)lines[i].y1, (float)lines[i].x2, (float)lines[i].y2);
+        }
+    });
+    double wuTime = bestMilliseconds(viaSink, [&]() {
+        FramebufferSink sink(viaSink, color);
+        for (size_t i = 0; i < lines.size(); i++) {
+            rasterLineWu(sink, (float)lines[i].x1, (float)lines[i].y1, (float)lines[i].x2, (float)lines[i].y2);
+        }
+    });
+    printf("  Bresenham, clipped %8.2f ms\n", aliasedTime);
+    printf("  Wu, clipped        %8.2f ms  (Wu / Bresenham %.2f)\n", wuTime, wuTime / aliasedTime);
+    return same ? 0 : 1;
+}
@@ -0,0 +1,302 @@
+#include "blend_spans.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BLEND_SPANS_SIMD 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define BLEND_SPANS_SIMD 1
+#endif
+
+// ========== SCALAR ==========
+// x / 255 rounded, exact for every product of two bytes
+static inline unsigned int div255(unsigned int x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+static inline unsigned int overPixel(unsigned int destination, unsigned int source) {
+    unsigned int inverse = 255 - (source >> 24);
+    unsigned int result = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        unsigned int value = ((source >> shift) & 255) + div255(((destination >> shift) & 255) * inverse);
+        result |= std::min(value, 255u) << shift;
+    }
+    return result;
+}
+
+static inline unsigned int addPixel(unsigned int destination, unsigned int source) {
+    unsigned int result = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        unsigned int value = ((destination >> shift) & 255) + ((source >> shift) & 255);
+        result |= std::min(value, 255u) << shift;
+    }
+    return result;
+}
+
+static inline unsigned int scalePixel(unsigned int source, unsigned int coverage) {
+    unsigned int result = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        result |= div255(((source >> shift) & 255) * coverage) << shift;
+    }
+    return result;
+}
+
+static inline unsigned int blendModePixel(unsigned int destination, unsigned int source, BlendMode mode) {
+    return mode == BLEND_ALPHA ? overPixel(destination, source) : addPixel(destination, source);
+}
+
+// ========== VECTORS ==========
+// The same arithmetic as the scalar code on 'width' pixels at a time, with
+// every channel widened to 16 bits for the multiplies
+#if defined(__AVX2__)
+struct PixelVector {
+    typedef __m256i Type;
+    static const int width = 8;
+
+    static Type load(const unsigned int* p) { return _mm256_loadu_si256((const __m256i*)p); }
+    static void store(unsigned int* p, Type v) { _mm256_storeu_si256((__m256i*)p, v); }
+    static Type splat(unsigned int pixel) { return _mm256_set1_epi32((int)pixel); }
+
+    // Coverage bytes repeated across the four channels of their pixel
+    static Type loadCoverage(const unsigned char* coverage) {
+        Type spread = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)coverage));
+        return _mm256_mullo_epi32(spread, _mm256_set1_epi32(0x01010101));
+    }
+
+    static Type div255(Type x) {
+        x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+        return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+    }
+    static Type alphas(Type wide) {
+        return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(wide, 0xFF), 0xFF);
+    }
+
+    static Type over(Type destination, Type source) {
+        const Type zero = _mm256_setzero_si256();
+        const Type full = _mm256_set1_epi16(255);
+        Type low = _mm256_unpacklo_epi8(destination, zero);
+        Type high = _mm256_unpackhi_epi8(destination, zero);
+        Type inverseLow = _mm256_sub_epi16(full, alphas(_mm256_unpacklo_epi8(source, zero)));
+        Type inverseHigh = _mm256_sub_epi16(full, alphas(_mm256_unpackhi_epi8(source, zero)));
+        low = div255(_mm256_mullo_epi16(low, inverseLow));
+        high = div255(_mm256_mullo_epi16(high, inverseHigh));
+        return _mm256_adds_epu8(_mm256_packus_epi16(low, high), source);
+    }
+    static Type add(Type destination, Type source) { return _mm256_adds_epu8(destination, source); }
+    static Type scale(Type source, Type coverage) {
+        const Type zero = _mm256_setzero_si256();
+        Type low = _mm256_mullo_epi16(_mm256_unpacklo_epi8(source, zero), _mm256_unpacklo_epi8(coverage, zero));
+        Type high = _mm256_mullo_epi16(_mm256_unpackhi_epi8(source, zero), _mm256_unpackhi_epi8(coverage, zero));
+        return _mm256_packus_epi16(div255(low), div255(high));
+    }
+};
+#elif defined(__SSE2__)
+struct PixelVector {
+    typedef __m128i Type;
+    static const int width = 4;
+
+    static Type load(const unsigned int* p) { return _mm_loadu_si128((const __m128i*)p); }
+    static void store(unsigned int* p, Type v) { _mm_storeu_si128((__m128i*)p, v); }
+    static Type splat(unsigned int pixel) { return _mm_set1_epi32((int)pixel); }
+
+    static Type loadCoverage(const unsigned char* coverage) {
+        int bytes;
+        std::memcpy(&bytes, coverage, sizeof(bytes));
+        Type spread = _mm_cvtsi32_si128(bytes);
+        spread = _mm_unpacklo_epi8(spread, spread);
+        return _mm_unpacklo_epi16(spread, spread);
+    }
+
+    static Type div255(Type x) {
+        x = _mm_add_epi16(x, _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+    static Type alphas(Type wide) {
+        return _mm_shufflehi_epi16(_mm_shufflelo_epi16(wide, 0xFF), 0xFF);
+    }
+
+    static Type over(Type destination, Type source) {
+        const Type zero = _mm_setzero_si128();
+        const Type full = _mm_set1_epi16(255);
+        Type low = _mm_unpacklo_epi8(destination, zero);
+        Type high = _mm_unpackhi_epi8(destination, zero);
+        Type inverseLow = _mm_sub_epi16(full, alphas(_mm_unpacklo_epi8(source, zero)));
+        Type inverseHigh = _mm_sub_epi16(full, alphas(_mm_unpackhi_epi8(source, zero)));
+        low = div255(_mm_mullo_epi16(low, inverseLow));
+        high = div255(_mm_mullo_epi16(high, inverseHigh));
+        return _mm_adds_epu8(_mm_packus_epi16(low, high), source);
+    }
+    static Type add(Type destination, Type source) { return _mm_adds_epu8(destination, source); }
+    static Type scale(Type source, Type coverage) {
+        const Type zero = _mm_setzero_si128();
+        Type low = _mm_mullo_epi16(_mm_unpacklo_epi8(source, zero), _mm_unpacklo_epi8(coverage, zero));
+        Type high = _mm_mullo_epi16(_mm_unpackhi_epi8(source, zero), _mm_unpackhi_epi8(coverage, zero));
+        return _mm_packus_epi16(div255(low), div255(high));
+    }
+};
+#endif
+
+// ========== GAMMA ==========
+// sRGB byte -> 12-bit linear light, and back
+struct GammaTables {
+    unsigned short toLinear[256];
+    unsigned char toEncoded[4096];
+};
+
+static GammaTables buildGammaTables() {
+    GammaTables tables;
+    for (int i = 0; i < 256; i++) {
+        double c = i / 255.0;
+        double linear = c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+        tables.toLinear[i] = (unsigned short)(linear * 4095.0 + 0.5);
+    }
+    for (int i = 0; i < 4096; i++) {
+        double linear = i / 4095.0;
+        double c = linear <= 0.0031308 ? linear * 12.92 : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+        tables.toEncoded[i] = (unsigned char)(c * 255.0 + 0.5);
+    }
+    return tables;
+}
+
+static const GammaTables& gammaTables() {
+    static const GammaTables tables = buildGammaTables();
+    return tables;
+}
+
+// A premultiplied color in linear light: RGB in 12 bits, alpha as stored
+struct LinearColor {
+    unsigned int channel[3];
+    unsigned int alpha;
+};
+
+static LinearColor linearColor(unsigned int premultiplied, unsigned int coverage) {
+    const GammaTables& tables = gammaTables();
+    unsigned int alpha = premultiplied >> 24;
+    LinearColor color;
+    color.alpha = div255(alpha * coverage);
+    for (int c = 0; c < 3; c++) {
+        // Premultiply again after linearizing the straight channel
+        unsigned int value = (premultiplied >> (8 * c)) & 255;
+        unsigned int straight = alpha ? std::min(255u, (value * 255 + alpha / 2) / alpha) : 0;
+        unsigned int linear = (tables.toLinear[straight] * alpha + 127) / 255;
+        color.channel[c] = (linear * coverage + 127) / 255;
+    }
+    return color;
+}
+
+static unsigned int blendLinearPixel(unsigned int destination, const LinearColor& source, BlendMode mode) {
+    const GammaTables& tables = gammaTables();
+    unsigned int inverse = mode == BLEND_ALPHA ? 255 - source.alpha : 255;
+    unsigned int result = 0;
+    for (int c = 0; c < 3; c++) {
+        unsigned int linear = tables.toLinear[(destination >> (8 * c)) & 255];
+        unsigned int blended = source.channel[c] + (linear * inverse + 127) / 255;
+        result |= (unsigned int)tables.toEncoded[std::min(blended, 4095u)] << (8 * c);
+    }
+    unsigned int alpha = destination >> 24;
+    alpha = source.alpha + (mode == BLEND_ALPHA ? div255(alpha * inverse) : alpha);
+    return result | std::min(alpha, 255u) << 24;
+}
+
+// ========== KERNELS ==========
+unsigned int premultiplyColor(unsigned int color) {
+    unsigned int alpha = color >> 24;
+    unsigned int result = alpha << 24;
+    for (int shift = 0; shift < 24; shift += 8) {
+        result |= div255(((color >> shift) & 255) * alpha) << shift;
+    }
+    return result;
+}
+
+void blendSpan(unsigned int* pixels, int count, unsigned int premultiplied,
+               BlendMode mode, bool gammaCorrect) {
+    if (gammaCorrect) {
+        LinearColor source = linearColor(premultiplied, 255);
+        for (int i = 0; i < count; i++) pixels[i] = blendLinearPixel(pixels[i], source, mode);
+        return;
+    }
+
+    int i = 0;
+#ifdef BLEND_SPANS_SIMD
+    const int w = PixelVector::width;
+    const PixelVector::Type source = PixelVector::splat(premultiplied);
+    if (mode == BLEND_ALPHA) {
+        for (; i + 2 * w <= count; i += 2 * w) {
+            PixelVector::Type first = PixelVector::load(pixels + i);
+            PixelVector::Type second = PixelVector::load(pixels + i + w);
+            PixelVector::store(pixels + i, PixelVector::over(first, source));
+            PixelVector::store(pixels + i + w, PixelVector::over(second, source));
+        }
+    } else {
+        for (; i + 2 * w <= count; i += 2 * w) {
+            PixelVector::Type first = PixelVector::load(pixels + i);
+            PixelVector::Type second = PixelVector::load(pixels + i + w);
+            PixelVector::store(pixels + i, PixelVector::add(first, source));
+            PixelVector::store(pixels + i + w, PixelVector::add(second, source));
+        }
+    }
+#endif
+    for (; i < count; i++) pixels[i] = blendModePixel(pixels[i], premultiplied, mode);
+}
+
+void blendSpanCoverage(unsigned int* pixels, const unsigned char* coverage, int count,
+                       unsigned int premultiplied, BlendMode mode, bool gammaCorrect) {
+    if (gammaCorrect) {
+        for (int i = 0; i < count; i++) {
+            if (coverage[i] == 0) continue;
+            pixels[i] = blendLinearPixel(pixels[i], linearColor(premultiplied, coverage[i]), mode);
+        }
+        return;
+    }
+
+    int i = 0;
+#ifdef BLEND_SPANS_SIMD
+    const int w = PixelVector::width;
+    const PixelVector::Type color = PixelVector::splat(premultiplied);
+    for (; i + 2 * w <= count; i += 2 * w) {
+        PixelVector::Type first = PixelVector::scale(color, PixelVector::loadCoverage(coverage + i));
+        PixelVector::Type second = PixelVector::scale(color, PixelVector::loadCoverage(coverage + i + w));
+        PixelVector::Type a = PixelVector::load(pixels + i);
+        PixelVector::Type b = PixelVector::load(pixels + i + w);
+        if (mode == BLEND_ALPHA) {
+            a = PixelVector::over(a, first);
+            b = PixelVector::over(b, second);
+        } else {
+            a = PixelVector::add(a, first);
+            b = PixelVector::add(b, second);
+        }
+        PixelVector::store(pixels + i, a);
+        PixelVector::store(pixels + i + w, b);
+    }
+#endif
+    for (; i < count; i++) {
+        pixels[i] = blendModePixel(pixels[i], scalePixel(premultiplied, coverage[i]), mode);
+    }
+}
+
+void blendSpanPixels(unsigned int* pixels, const unsigned int* sources, int count, BlendMode mode) {
+    int i = 0;
+#ifdef BLEND_SPANS_SIMD
+    const int w = PixelVector::width;
+    for (; i + 2 * w <= count; i += 2 * w) {
+        PixelVector::Type a = PixelVector::load(pixels + i);
+        PixelVector::Type b = PixelVector::load(pixels + i + w);
+        PixelVector::Type first = PixelVector::load(sources + i);
+        PixelVector::Type second = PixelVector::load(sources + i + w);
+        if (mode == BLEND_ALPHA) {
+            a = PixelVector::over(a, first);
+            b = PixelVector::over(b, second);
+        } else {
+            a = PixelVector::add(a, first);
+            b = PixelVector::add(b, second);
+        }
+        PixelVector::store(pixels + i, a);
+        PixelVector::store(pixels + i + w, b);
+    }
+#endif
+    for (; i < count; i++) pixels[i] = blendModePixel(pixels[i], sources[i], mode);
+}
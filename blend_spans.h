@@ -0,0 +1,41 @@
+// blend_spans.h
+#ifndef BLEND_SPANS_H
+#define BLEND_SPANS_H
+
+// ================== FRAMEBUFFER BLEND SPANS ==================
+// Blending runs of framebuffer pixels (framebuffer.h byte order R, G, B,
+// A) with premultiplied colors, the software counterparts of
+//
+//   BLEND_ALPHA     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA)
+//   BLEND_ADDITIVE  glBlendFunc(GL_SRC_ALPHA, GL_ONE)
+//
+// for a straight color; with the color premultiplied these become
+// src + dst * (1 - srcAlpha) and src + dst. Each kernel runs 16 pixels per
+// loop iteration with AVX2, 8 with SSE2, and falls back to scalar code on
+// other targets; all three give identical results.
+//
+// With 'gammaCorrect' the color channels are blended in linear light
+// through lookup tables (sRGB encoding) instead of on the stored values.
+// That path is scalar.
+enum BlendMode {
+    BLEND_ALPHA,
+    BLEND_ADDITIVE
+};
+
+// Straight RGBA -> premultiplied RGBA
+unsigned int premultiplyColor(unsigned int color);
+
+// One premultiplied color over every pixel of the span
+void blendSpan(unsigned int* pixels, int count, unsigned int premultiplied,
+               BlendMode mode, bool gammaCorrect = false);
+
+// One premultiplied color scaled per pixel by coverage / 255 (anti-aliased
+// edges)
+void blendSpanCoverage(unsigned int* pixels, const unsigned char* coverage, int count,
+                       unsigned int premultiplied, BlendMode mode, bool gammaCorrect = false);
+
+// A span of premultiplied source pixels (sprites, layers) composited onto
+// the framebuffer as stored, without gamma conversion
+void blendSpanPixels(unsigned int* pixels, const unsigned int* sources, int count, BlendMode mode);
+
+#endif
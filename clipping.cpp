@@ -0,0 +1,85 @@
+#include "clipping.h"
+#include <algorithm>
+#include <vector>
+
+typedef std::pair<float, float> ClipVertex;
+
+enum ClipEdge { CLIP_LEFT, CLIP_RIGHT, CLIP_BOTTOM, CLIP_TOP };
+
+static bool insideEdge(const ClipVertex& v, int edge, float bound) {
+    switch (edge) {
+        case CLIP_LEFT:   return v.first >= bound;
+        case CLIP_RIGHT:  return v.first <= bound;
+        case CLIP_BOTTOM: return v.second >= bound;
+        default:          return v.second <= bound;
+    }
+}
+
+// Where the edge a-b crosses the boundary line
+static ClipVertex crossEdge(const ClipVertex& a, const ClipVertex& b, int edge, float bound) {
+    ClipVertex result;
+    if (edge == CLIP_LEFT || edge == CLIP_RIGHT) {
+        float t = (bound - a.first) / (b.first - a.first);
+        result.first = bound;
+        result.second = a.second + t * (b.second - a.second);
+    } else {
+        float t = (bound - a.second) / (b.second - a.second);
+        result.first = a.first + t * (b.first - a.first);
+        result.second = bound;
+    }
+    return result;
+}
+
+static void clipAgainstEdge(const ClipVertex* in, size_t count, int edge, float bound,
+                            std::vector<ClipVertex>& out) {
+    out.clear();
+    for (size_t i = 0; i < count; i++) {
+        const ClipVertex& current = in[i];
+        const ClipVertex& previous = in[(i + count - 1) % count];
+        bool currentInside = insideEdge(current, edge, bound);
+        bool previousInside = insideEdge(previous, edge, bound);
+
+        if (currentInside != previousInside) {
+            out.push_back(crossEdge(previous, current, edge, bound));
+        }
+        if (currentInside) {
+            out.push_back(current);
+        }
+    }
+}
+
+static thread_local std::vector<ClipVertex> clipBuffers[2];
+
+const ClipVertex* clipPolygon(const ClipVertex* vertices, size_t count,
+                              const RasterRect& rect, size_t& clippedCount) {
+    clippedCount = 0;
+    if (count == 0) return vertices;
+
+    // Most polygons are either wholly on screen or wholly off it
+    float left = vertices[0].first, right = left;
+    float bottom = vertices[0].second, top = bottom;
+    for (size_t i = 1; i < count; i++) {
+        left = std::min(left, vertices[i].first);
+        right = std::max(right, vertices[i].first);
+        bottom = std::min(bottom, vertices[i].second);
+        top = std::max(top, vertices[i].second);
+    }
+    if (!rectOverlaps(rect, left, bottom, right, top)) return vertices;
+    if (left >= rect.left && right <= rect.right && bottom >= rect.bottom && top <= rect.top) {
+        clippedCount = count;
+        return vertices;
+    }
+
+    const float bounds[4] = {rect.left, rect.right, rect.bottom, rect.top};
+    const ClipVertex* in = vertices;
+    size_t inCount = count;
+    for (int edge = 0; edge < 4 && inCount > 0; edge++) {
+        std::vector<ClipVertex>& out = clipBuffers[edge & 1];
+        clipAgainstEdge(in, inCount, edge, bounds[edge], out);
+        in = out.data();
+        inCount = out.size();
+    }
+
+    clippedCount = inCount;
+    return in;
+}
@@ -0,0 +1,97 @@
+// clipping.h
+#ifndef CLIPPING_H
+#define CLIPPING_H
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+// ================== VIEWPORT CLIPPING ==================
+// Primitives are clipped against the visible rectangle of their sink, in
+// the sink's own coordinates, before they are rasterized.
+struct RasterRect {
+    float left, bottom, right, top;
+};
+
+// Liang-Barsky: clip the segment to 'rect' in place. Returns false when
+// no part of it is inside.
+inline bool clipLine(float& x1, float& y1, float& x2, float& y2, const RasterRect& rect) {
+    float dx = x2 - x1;
+    float dy = y2 - y1;
+    float p[4] = {-dx, dx, -dy, dy};
+    float q[4] = {x1 - rect.left, rect.right - x1, y1 - rect.bottom, rect.top - y1};
+    float bound[4] = {rect.left, rect.right, rect.bottom, rect.top};
+    float enter = 0.0f;
+    float leave = 1.0f;
+    int enterEdge = -1;
+    int leaveEdge = -1;
+
+    for (int edge = 0; edge < 4; edge++) {
+        if (p[edge] == 0.0f) {
+            // Parallel to this edge: inside or entirely out
+            if (q[edge] < 0.0f) return false;
+            continue;
+        }
+        float t = q[edge] / p[edge];
+        if (p[edge] < 0.0f) {
+            if (t > leave) return false;
+            if (t > enter) {
+                enter = t;
+                enterEdge = edge;
+            }
+        } else {
+            if (t < enter) return false;
+            if (t < leave) {
+                leave = t;
+                leaveEdge = edge;
+            }
+        }
+    }
+
+    // The clipped coordinate is set to the edge itself: interpolating it
+    // could land a hair inside and truncate to the wrong pixel
+    if (leaveEdge >= 0) {
+        x2 = (leaveEdge < 2) ? bound[leaveEdge] : x1 + leave * dx;
+        y2 = (leaveEdge < 2) ? y1 + leave * dy : bound[leaveEdge];
+    }
+    if (enterEdge >= 0) {
+        x1 = (enterEdge < 2) ? bound[enterEdge] : x1 + enter * dx;
+        y1 = (enterEdge < 2) ? y1 + enter * dy : bound[enterEdge];
+    }
+    return true;
+}
+
+// Narrow the integer range [first, last] to [low, high]. Returns false
+// when nothing is left.
+inline bool clipRange(int& first, int& last, float low, float high) {
+    if (last < low || first > high) return false;
+    if (first < low) first = static_cast<int>(std::ceil(low));
+    if (last > high) last = static_cast<int>(std::floor(high));
+    return first <= last;
+}
+
+inline bool rectOverlaps(const RasterRect& rect, float left, float bottom, float right, float top) {
+    return left <= rect.right && right >= rect.left && bottom <= rect.top && top >= rect.bottom;
+}
+
+// True when the whole rectangle lies strictly inside the ellipse, so an
+// outline of it has nothing to draw
+inline bool rectInsideEllipse(const RasterRect& rect, float xc, float yc, float rx, float ry) {
+    if (rx <= 0.0f || ry <= 0.0f) return false;
+    double corners[4][2] = {{rect.left, rect.bottom}, {rect.right, rect.bottom},
+                            {rect.left, rect.top}, {rect.right, rect.top}};
+    for (int i = 0; i < 4; i++) {
+        double u = (corners[i][0] - xc) / rx;
+        double v = (corners[i][1] - yc) / ry;
+        if (u * u + v * v >= 1.0) return false;
+    }
+    return true;
+}
+
+// Sutherland-Hodgman: the convex or concave polygon cut down to 'rect'.
+// Returns the clipped vertices, 'clippedCount' of them (possibly none);
+// the storage is per thread and valid until the next call on that thread.
+const std::pair<float, float>* clipPolygon(const std::pair<float, float>* vertices, size_t count,
+                                           const RasterRect& rect, size_t& clippedCount);
+
+#endif
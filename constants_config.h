@@ -23,9 +23,113 @@ const float INITIAL_CAMERA_Y = 300.0f;
 const float INITIAL_DAY_TIME = 0.5f;
 const float INITIAL_WIND_SPEED = 0.1f;
 const float INITIAL_WIND_DIRECTION = 1.0f;
+const int INITIAL_CLOUD_COUNT = 8;
+const int INITIAL_SATELLITE_COUNT = 3;
+const int INITIAL_METEOR_COUNT = 2;
+
+// Scenario packs (binary scenario files, see scenario.h)
+const char SCENARIO_PACK_EXTENSION[] = ".rks";
+
+// Simulation checkpoints (see simulation_checkpoint.h)
+const char CHECKPOINT_EXTENSION[] = ".rkcp";
+const char CHECKPOINT_FILE[] = "quicksave.rkcp"; // F5 saves, F9 loads
 
 // Graphics constants
 const int SCREEN_WIDTH = 800;
 const int SCREEN_HEIGHT = 600;
 
+// Integration (one step = one 16ms timer tick at the default step size)
+const float DEFAULT_SIMULATION_STEP = 1.0f;
+const float INTEGRATOR_TOLERANCE = 1e-3f;
+const float INTEGRATOR_MIN_STEP = 1e-3f;
+const int INTEGRATOR_MAX_SUBSTEPS = 64;
+const int INTEGRATOR_EVENT_ITERATIONS = 16;
+
+// Time warp (simulation ticks per rendered frame)
+const int TIME_WARP_LEVELS[] = {1, 2, 5, 10, 50, 100, 1000};
+const int TIME_WARP_LEVEL_COUNT = sizeof(TIME_WARP_LEVELS) / sizeof(TIME_WARP_LEVELS[0]);
+const float TIME_WARP_SEPARATION_MARGIN = 120.0f; // Ticks before a separation to drop to 1x
+
+// Meteor trails (fixed circular buffer per meteor)
+const int METEOR_TRAIL_CAPACITY = 16;
+
+// Trajectory history (online decimation)
+const int TRAJECTORY_HISTORY_CAPACITY = 512;
+const float TRAJECTORY_MIN_SPACING = 2.0f;
+const float TRAJECTORY_TOLERANCE = 0.25f;
+const float TRAJECTORY_DRAW_PIXEL_SPACING = 2.0f;
+
+// Trajectory prediction (cached, advanced incrementally)
+const int TRAJECTORY_PREDICTION_HORIZON = 600; // Ticks predicted ahead (~10s at 60 FPS)
+const float TRAJECTORY_PREDICTION_TOLERANCE = 1e-3f; // Drift allowed before recomputing
+
+// Trajectory fan (candidate manual inputs, predicted in SIMD lanes)
+const int TRAJECTORY_FAN_CANDIDATES = 16;
+const int TRAJECTORY_FAN_MAX_CANDIDATES = 32;
+const int TRAJECTORY_FAN_HORIZON = 240; // Ticks predicted ahead
+const int TRAJECTORY_FAN_SAMPLE_INTERVAL = 4;
+const int TRAJECTORY_FAN_POINTS = TRAJECTORY_FAN_HORIZON / TRAJECTORY_FAN_SAMPLE_INTERVAL;
+const float MANUAL_THRUST_STEP = 0.05f; // Velocity change per UP/DOWN arrow press
+const float MANUAL_THRUST_FUEL = 1.0f;  // Fuel spent per UP arrow press
+
+// Text rendering (glyph atlas for the 9x15 HUD font)
+const int TEXT_ATLAS_WIDTH = 256;
+const int TEXT_ATLAS_HEIGHT = 128;
+const int TEXT_ATLAS_COLUMNS = 16; // Glyph cells per atlas row
+const int TEXT_BUFFER_CAPACITY = 96;
+const int TEXT_RUN_CAPACITY = 96;
+
+// Procedural starfield (world tiles generated on demand)
+const float STARFIELD_TILE_SIZE = 256.0f;
+const float STARFIELD_MIN_Y = 300.0f;         // Stars only above this height
+const int STARFIELD_STARS_PER_TILE = 80;      // Multiple of 4 (SIMD twinkle)
+const int STARFIELD_CACHE_TILES = 128;
+const int STARFIELD_HASH_BUCKETS = 256;       // Power of two
+const float STARFIELD_CACHE_MIN_FRACTION = 0.25f; // Below this, tiles are not cached
+const float STARFIELD_MIN_BRIGHTNESS = 1.0f / 255.0f;
+const float STARFIELD_DAYLIGHT_RAMP = 0.05f;  // Day-time span over which stars fade out
+
+// Terrain heightfield (streamed in chunks around the camera)
+const float TERRAIN_SAMPLE_SPACING = 20.0f;
+const int TERRAIN_CHUNK_SAMPLES = 32;
+const int TERRAIN_RESIDENT_CHUNKS = 16; // Covers the widest view (zoom 0.1) plus margin
+
+// Frame capture (writer thread behind a bounded queue)
+const int CAPTURE_FRAMEBUFFERS = 2;           // Frames in flight between render and writer
+const int CAPTURE_FPS = 60;                   // Matches the 16 ms display timer
+const int CAPTURE_DROP_REPORT_INTERVAL = 60;  // Report every N dropped frames
+
+// Simulation thread (fixed frame, input queue, delayed callbacks)
+const int SIMULATION_FRAME_MS = 16;
+const int SIMULATION_MAX_LAG_MS = 250;  // Skip ahead instead of catching up after a stall
+const int INPUT_QUEUE_CAPACITY = 64;    // Power of two
+const int SIMULATION_MAX_CALLBACKS = 8;
+
+// Job system (work-stealing update passes)
+const int JOB_MAX_WORKERS = 8;
+const int JOB_POOL_CAPACITY = 1024;   // Jobs per batch
+const int JOB_MAX_DEPENDENTS = 4;     // Jobs waiting on one job
+const int PARTICLE_JOB_GRAIN = 512;   // Particles per parallel range
+const int PARTICLE_JOB_MIN_COUNT = 1024; // Fewer particles are updated inline
+
+// Buffered rasterizer output (see raster_batch.h)
+const int RASTER_BATCH_CAPACITY = 16384; // Vertices per glDrawArrays
+
+// Filled circle / ellipse span table cache (see span_tables.h)
+const int SPAN_CACHE_SLOTS = 1024;     // Cached tables (power of two)
+const int SPAN_CACHE_ROWS = 65536;     // Rows stored across all tables
+
+// Viewport clipping
+const float RASTER_CLIP_MARGIN = 0.01f; // Of the visible extent, for wide points
+
+// Anti-aliased rasterization (see rasterizer_aa.h)
+const float COVERAGE_SOLID = 255.5f / 256.0f; // Drawn as a solid run from here up
+const float COVERAGE_EMPTY = 0.5f / 256.0f;   // Skipped below this
+const int COVERAGE_CHUNK = 64;                // Pixels of coverage computed per batch
+const int RASTER_PREFETCH_DISTANCE = 16;      // Wu columns read ahead of the blend
+
+// Level of detail (screen-space targets for round primitives)
+const float LOD_PIXELS_PER_SEGMENT = 3.0f;
+const float LOD_POINT_RADIUS = 1.0f;
+
 #endif
\ No newline at end of file
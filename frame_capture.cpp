@@ -0,0 +1,256 @@
+#include "frame_capture.h"
+#include "constants_config.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#ifdef __APPLE__
+#include <GLUT/glut.h>
+#else
+#include <GL/glut.h>
+#endif
+
+// ========== CAPTURE STATE ==========
+// Everything below 'mutex' is shared with the writer thread and guarded by
+// it; the output stream and conversion scratch belong to the writer while
+// a capture runs.
+struct CaptureState {
+    bool active;
+    CaptureFormat format;
+    std::string path;
+    int width, height;
+    FILE* stream;
+    bool writeFailed;
+    std::vector<unsigned char> scratch;
+    std::thread writer;
+
+    std::mutex mutex;
+    std::condition_variable frameQueued;
+    bool stopping;
+    Framebuffer frames[CAPTURE_FRAMEBUFFERS];
+    Framebuffer* freeFrames[CAPTURE_FRAMEBUFFERS];
+    int freeCount;
+    Framebuffer* queue[CAPTURE_FRAMEBUFFERS]; // Ring, oldest at queueHead
+    int queueHead, queueCount;
+    unsigned long written, dropped;
+
+    CaptureState() : active(false), format(CAPTURE_Y4M), width(0), height(0), stream(0),
+                     writeFailed(false), stopping(false), freeCount(0), queueHead(0),
+                     queueCount(0), written(0), dropped(0) {}
+};
+
+static CaptureState capture;
+
+// ========== FRAME ENCODING (writer thread) ==========
+static unsigned char clampByte(int value) {
+    return (unsigned char)(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+// Y4M: one "FRAME" header and full-resolution Y, Cb, Cr planes top to bottom
+// (BT.601 studio range, the format's default)
+static bool writeY4MFrame(const Framebuffer& frame) {
+    size_t planeSize = (size_t)frame.width * frame.height;
+    capture.scratch.resize(planeSize * 3);
+    unsigned char* planeY = &capture.scratch[0];
+    unsigned char* planeU = planeY + planeSize;
+    unsigned char* planeV = planeU + planeSize;
+
+    for (int row = 0; row < frame.height; row++) {
+        const unsigned char* source = (const unsigned char*)framebufferRow(frame, frame.height - 1 - row);
+        size_t offset = (size_t)row * frame.width;
+        for (int col = 0; col < frame.width; col++) {
+            int r = source[col * 4];
+            int g = source[col * 4 + 1];
+            int b = source[col * 4 + 2];
+            planeY[offset + col] = clampByte(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+            planeU[offset + col] = clampByte(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            planeV[offset + col] = clampByte(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+    }
+
+    return std::fputs("FRAME\n", capture.stream) >= 0 &&
+           std::fwrite(&capture.scratch[0], 1, capture.scratch.size(), capture.stream) == capture.scratch.size();
+}
+
+static bool writePPMFrame(const Framebuffer& frame, unsigned long index) {
+    char name[512];
+    std::snprintf(name, sizeof(name), "%s_%05lu.ppm", capture.path.c_str(), index);
+    FILE* file = std::fopen(name, "wb");
+    if (!file) return false;
+
+    size_t rowBytes = (size_t)frame.width * 3;
+    capture.scratch.resize(rowBytes * frame.height);
+    for (int row = 0; row < frame.height; row++) {
+        const unsigned char* source = (const unsigned char*)framebufferRow(frame, frame.height - 1 - row);
+        unsigned char* target = &capture.scratch[row * rowBytes];
+        for (int col = 0; col < frame.width; col++) {
+            target[col * 3] = source[col * 4];
+            target[col * 3 + 1] = source[col * 4 + 1];
+            target[col * 3 + 2] = source[col * 4 + 2];
+        }
+    }
+
+    bool ok = std::fprintf(file, "P6\n%d %d\n255\n", frame.width, frame.height) > 0 &&
+              std::fwrite(&capture.scratch[0], 1, capture.scratch.size(), file) == capture.scratch.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+static void writerLoop() {
+    std::unique_lock<std::mutex> lock(capture.mutex);
+    for (;;) {
+        capture.frameQueued.wait(lock, [] { return capture.queueCount > 0 || capture.stopping; });
+        if (capture.queueCount == 0) break; // Stopping and fully drained
+
+        Framebuffer* frame = capture.queue[capture.queueHead];
+        capture.queueHead = (capture.queueHead + 1) % CAPTURE_FRAMEBUFFERS;
+        capture.queueCount--;
+        unsigned long index = capture.written;
+        lock.unlock();
+
+        // Keep draining after an error so the render loop is never blocked
+        if (!capture.writeFailed) {
+            bool ok = (capture.format == CAPTURE_Y4M) ? writeY4MFrame(*frame)
+                                                      : writePPMFrame(*frame, index);
+            if (!ok) {
+                capture.writeFailed = true;
+                std::cout << "Capture: write to " << capture.path << " failed" << std::endl;
+            }
+        }
+
+        lock.lock();
+        capture.freeFrames[capture.freeCount++] = frame;
+        capture.written++;
+    }
+}
+
+// ========== CONTROL (render thread) ==========
+bool startFrameCapture(CaptureFormat format, const char* path, int width, int height, int fps) {
+    if (capture.active || width <= 0 || height <= 0) return false;
+
+    static bool exitHandlerInstalled = false;
+    if (!exitHandlerInstalled) {
+        // The writer must be joined before static destruction
+        std::atexit(stopFrameCapture);
+        exitHandlerInstalled = true;
+    }
+
+    capture.format = format;
+    capture.path = path;
+    capture.width = width;
+    capture.height = height;
+    capture.stream = 0;
+    capture.writeFailed = false;
+
+    if (format == CAPTURE_Y4M) {
+        capture.stream = std::fopen(path, "wb");
+        if (!capture.stream) {
+            std::cout << "Capture: cannot open " << path << std::endl;
+            return false;
+        }
+        std::fprintf(capture.stream, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", width, height, fps);
+    }
+
+    for (int i = 0; i < CAPTURE_FRAMEBUFFERS; i++) {
+        resizeFramebuffer(capture.frames[i], width, height);
+        capture.freeFrames[i] = &capture.frames[i];
+    }
+    capture.freeCount = CAPTURE_FRAMEBUFFERS;
+    capture.queueHead = 0;
+    capture.queueCount = 0;
+    capture.written = 0;
+    capture.dropped = 0;
+    capture.stopping = false;
+    capture.writer = std::thread(writerLoop);
+    capture.active = true;
+
+    std::cout << "Capture started: " << path << " (" << width << "x" << height << ")" << std::endl;
+    return true;
+}
+
+void stopFrameCapture() {
+    if (!capture.active) return;
+
+    {
+        std::lock_guard<std::mutex> lock(capture.mutex);
+        capture.stopping = true;
+    }
+    capture.frameQueued.notify_one();
+    capture.writer.join();
+    capture.active = false;
+
+    if (capture.stream) {
+        std::fclose(capture.stream);
+        capture.stream = 0;
+    }
+    for (int i = 0; i < CAPTURE_FRAMEBUFFERS; i++) {
+        std::vector<unsigned int>().swap(capture.frames[i].pixels);
+    }
+
+    std::cout << "Capture stopped: " << capture.written << " frames written, "
+              << capture.dropped << " dropped" << std::endl;
+}
+
+bool frameCaptureActive() {
+    return capture.active;
+}
+
+Framebuffer* acquireCaptureFrame() {
+    if (!capture.active) return 0;
+
+    std::lock_guard<std::mutex> lock(capture.mutex);
+    if (capture.freeCount == 0) {
+        capture.dropped++;
+        if (capture.dropped == 1 || capture.dropped % CAPTURE_DROP_REPORT_INTERVAL == 0) {
+            std::cout << "Capture: writer falling behind, " << capture.dropped
+                      << " frames dropped" << std::endl;
+        }
+        return 0;
+    }
+    return capture.freeFrames[--capture.freeCount];
+}
+
+void submitCaptureFrame(Framebuffer* frame) {
+    {
+        std::lock_guard<std::mutex> lock(capture.mutex);
+        int tail = (capture.queueHead + capture.queueCount) % CAPTURE_FRAMEBUFFERS;
+        capture.queue[tail] = frame;
+        capture.queueCount++;
+    }
+    capture.frameQueued.notify_one();
+}
+
+void captureGLFrame() {
+    Framebuffer* frame = acquireCaptureFrame();
+    if (!frame) return;
+
+    // The window may have been resized since the capture started: read the
+    // overlapping part and leave the rest black
+    int width = std::min(frame->width, glutGet(GLUT_WINDOW_WIDTH));
+    int height = std::min(frame->height, glutGet(GLUT_WINDOW_HEIGHT));
+    if (width != frame->width || height != frame->height) {
+        std::fill(frame->pixels.begin(), frame->pixels.end(), 0u);
+    }
+
+    glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glPixelStorei(GL_PACK_ROW_LENGTH, frame->width);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, &frame->pixels[0]);
+    glPopClientAttrib();
+
+    submitCaptureFrame(frame);
+}
+
+unsigned long captureFramesWritten() {
+    std::lock_guard<std::mutex> lock(capture.mutex);
+    return capture.written;
+}
+
+unsigned long captureFramesDropped() {
+    std::lock_guard<std::mutex> lock(capture.mutex);
+    return capture.dropped;
+}
@@ -0,0 +1,39 @@
+// frame_capture.h
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include "framebuffer.h"
+
+// ================== FRAME CAPTURE ==================
+// Frames are copied into one of CAPTURE_FRAMEBUFFERS preallocated
+// framebuffers and handed to a writer thread through a bounded queue. The
+// render loop never waits on disk: when every framebuffer is still queued
+// or being written, the frame is dropped and counted instead.
+enum CaptureFormat {
+    CAPTURE_Y4M,          // One YUV4MPEG2 stream (4:4:4, BT.601)
+    CAPTURE_PPM_SEQUENCE  // Numbered binary PPM files
+};
+
+// Start writing frames of width x height. 'path' is the .y4m file or the
+// prefix of the PPM files (<path>_00000.ppm, ...). Returns false if a
+// capture is already running or the output cannot be opened.
+bool startFrameCapture(CaptureFormat format, const char* path, int width, int height, int fps);
+
+// Flush the queued frames, join the writer thread and print a summary
+void stopFrameCapture();
+
+bool frameCaptureActive();
+
+// Free framebuffer to render or copy a frame into, or 0 if the writer is
+// behind (the frame is counted as dropped). Every acquired framebuffer
+// must be passed back through submitCaptureFrame.
+Framebuffer* acquireCaptureFrame();
+void submitCaptureFrame(Framebuffer* frame);
+
+// Read the current GL color buffer into a capture frame and submit it
+void captureGLFrame();
+
+unsigned long captureFramesWritten();
+unsigned long captureFramesDropped();
+
+#endif
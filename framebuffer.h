@@ -0,0 +1,41 @@
+// framebuffer.h
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <cstddef>
+#include <vector>
+
+// ================== SOFTWARE FRAMEBUFFER ==================
+// 32-bit pixels in memory byte order R, G, B, A (glReadPixels GL_RGBA /
+// GL_UNSIGNED_BYTE), rows stored bottom to top like the GL window.
+struct Framebuffer {
+    int width;
+    int height;
+    std::vector<unsigned int> pixels;
+
+    Framebuffer() : width(0), height(0) {}
+};
+
+inline void resizeFramebuffer(Framebuffer& framebuffer, int width, int height) {
+    framebuffer.width = width;
+    framebuffer.height = height;
+    framebuffer.pixels.assign((size_t)width * height, 0);
+}
+
+inline unsigned int* framebufferRow(Framebuffer& framebuffer, int y) {
+    return &framebuffer.pixels[(size_t)y * framebuffer.width];
+}
+
+inline const unsigned int* framebufferRow(const Framebuffer& framebuffer, int y) {
+    return &framebuffer.pixels[(size_t)y * framebuffer.width];
+}
+
+// 'source' over 'destination' at alpha / 256, two channels per multiply
+inline unsigned int blendPixel(unsigned int destination, unsigned int source, unsigned int alpha) {
+    unsigned int inverse = 256 - alpha;
+    unsigned int redBlue = ((source & 0x00FF00FFu) * alpha + (destination & 0x00FF00FFu) * inverse) >> 8;
+    unsigned int greenAlpha = ((source >> 8) & 0x00FF00FFu) * alpha + ((destination >> 8) & 0x00FF00FFu) * inverse;
+    return (redBlue & 0x00FF00FFu) | (greenAlpha & 0xFF00FF00u);
+}
+
+#endif
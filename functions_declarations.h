@@ -2,72 +2,93 @@
 #define FUNCTIONS_DECLARATIONS_H
 
 #include "types_structures.h"
+#include "rocket_physics.h"
+#include "scenario.h"
 #include <string>
 
 // ========== GRAPHICS FUNCTIONS ==========
+// Render thread: the scene is drawn from the snapshot being displayed
+// (simulation_snapshot.h), never from the simulation globals
+struct SimulationSnapshot;
+
 // Basic drawing
 void drawSeparatedStage(const RocketStage& stage, int stageNum);
 void drawFirstStage();
 void drawSecondStage(float yOffset);
 void drawThirdStage(float yOffset);
-void drawRocket();
-void drawFlames();
-void drawFlamesForStage(int stageNum);
+void drawRocket(const SimulationSnapshot& state);
+void drawFlames(const SimulationSnapshot& state);
+void drawFlamesForStage(const SimulationSnapshot& state, int stageNum);
 
 // Environment drawing
-void drawStars();
-void drawSky();
-void drawGround();
-void drawLaunchPad();
-void drawLaunchComplex();
+void drawStars(const SimulationSnapshot& state);
+void drawSky(const SimulationSnapshot& state);
+void drawGround(const SimulationSnapshot& state);
+void drawLaunchPad(const SimulationSnapshot& state);
+void drawLaunchComplex(const SimulationSnapshot& state);
 void drawControlTower();
-void drawGrid();
-void drawClouds();
-void drawSatellites();
-void drawMeteors();
-void drawTrajectory();
-void drawSmoke();
-void drawExplosion();
+void drawGrid(const SimulationSnapshot& state);
+void drawClouds(const SimulationSnapshot& state);
+void drawSatellites(const SimulationSnapshot& state);
+void drawMeteors(const SimulationSnapshot& state);
+void drawTrajectory(const SimulationSnapshot& state);
+void drawSmoke(const SimulationSnapshot& state);
+void drawExplosion(const SimulationSnapshot& state);
 
 // UI drawing
+void drawText(float x, float y, const char* text);
 void drawText(float x, float y, const std::string& text);
 void drawGauge(float x, float y, float value, float maxValue, 
                const std::string& label, float r, float g, float b);
-void drawUI();
-void drawCountdown();
+void drawUI(const SimulationSnapshot& state);
+void drawCountdown(const SimulationSnapshot& state);
 
 // ========== INITIALIZATION FUNCTIONS ==========
-void initializeStars();
+void initializeStars(const ScenarioConfig& config);
 void initializeClouds();
 void initializeSatellites();
 void initializeMeteors();
 void initializeStages();
+void applyScenario(const ScenarioConfig& config);
+int simulationRandom();
+float simulationSeconds();
 
 // ========== UPDATE FUNCTIONS ==========
-void updateStars();
-void updateClouds();
-void updateSatellites();
-void updateMeteors();
-void updateSmoke();
-void updateExplosion();
+void updateScenery();    // Clouds, satellites and meteors (parallel jobs)
+void updateParticles();  // Smoke and explosion particles (parallel jobs)
 void updateRocket();
 void updateCamera();
 void updateDayNight();
 void updateSeparatedStages();
+void simulationFrame();
+void stepSimulation();
+void updateVisuals();
 
 // ========== SPECIAL EFFECTS ==========
 void createExplosion(float x, float y);
 void createStageSeparationEffect(float x, float y, int stageNum);
 void separateStage(int stageNum);
+void releaseSeparatedStage(int stageNum, const RocketFlightState& before);
 
 // ========== UTILITY FUNCTIONS ==========
 void testSeparation();
 void switchCameraToRocket(int value);
+float ticksUntilSeparation();
+void setTimeWarpLevel(int level);
+
+// ========== FLIGHT STATE ==========
+RocketFlightState currentRocketFlightState();
+void storeRocketFlightState(const RocketFlightState& state);
+FlightConditions currentFlightConditions();
 
 // ========== INPUT HANDLING ==========
-// These will be implemented in main.cpp or input.cpp
+// GLUT callbacks (GLUT thread) queue input for the simulation thread,
+// which applies it through the handle* functions
 void keyboard(unsigned char key, int x, int y);
 void keyboardUp(unsigned char key, int x, int y);
 void specialKeys(int key, int x, int y);
+void handleKeyDown(unsigned char key);
+void handleKeyUp(unsigned char key);
+void handleSpecialKey(int key);
 
 #endif
\ No newline at end of file
@@ -27,6 +27,17 @@ bool stage2Falling = false;
 float stage1FallTime = 0.0f;
 float stage2FallTime = 0.0f;
 
+// Integration settings
+IntegratorType currentIntegrator = INTEGRATOR_SEMI_IMPLICIT_EULER;
+float simulationStep = DEFAULT_SIMULATION_STEP;
+unsigned long simulationTick = 0;
+unsigned long long simulationRandomCounter = 0;
+
+// Time warp
+int timeWarpLevel = 0;
+bool visualEffectsEnabled = true;
+int flightEventCount = 0;
+
 // ========== CAMERA VARIABLES ==========
 float cameraZoom = INITIAL_CAMERA_ZOOM;
 float cameraX = INITIAL_CAMERA_X;
@@ -53,14 +64,19 @@ float windDirection = INITIAL_WIND_DIRECTION;
 bool showStats = true;
 bool showGrid = false;
 bool showTrajectory = false;
-std::vector<std::pair<float, float>> trajectoryPoints;
+TrajectoryHistory trajectoryHistory = {{0.0f}, {0.0f}, 0, TRAJECTORY_MIN_SPACING, TRAJECTORY_TOLERANCE,
+                                          0.0f, 0.0f, 0.0f, 0.0f};
+TrajectoryPrediction trajectoryPrediction;
+TrajectoryFan trajectoryFan;
 
 // ========== GAME STATE ==========
 GameState currentState = PRELAUNCH;
 
 // ========== COLLECTIONS ==========
-std::vector<Star> stars;
+Starfield starfield;
+Terrain terrain;
 std::vector<SmokeParticle> smokeParticles;
+unsigned int nextParticleId = 0;
 std::vector<Cloud> clouds;
 std::vector<ExplosionParticle> explosionParticles;
 std::vector<Satellite> satellites;
@@ -71,5 +87,8 @@ float targetAltitude = INITIAL_TARGET_ALTITUDE;
 float targetVelocity = INITIAL_TARGET_VELOCITY;
 bool missionSuccess = false;
 
+// ========== SCENARIO ==========
+ScenarioConfig scenario = defaultScenario();
+
 // ========== KEYBOARD TRACKING ==========
 bool keys[256] = {false};
\ No newline at end of file
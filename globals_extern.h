@@ -2,9 +2,21 @@
 #define GLOBALS_EXTERN_H
 
 #include "types_structures.h"
+#include "trajectory_history.h"
+#include "trajectory_predictor.h"
+#include "trajectory_fan.h"
+#include "starfield.h"
+#include "terrain.h"
+#include "scenario.h"
+#include "integrator.h"
 #include <vector>
 #include <utility>
 
+// The simulation state belongs to the simulation thread once it starts;
+// the render thread draws from published snapshots of it and never reads
+// these (see simulation_snapshot.h). The starfield, terrain cache and
+// trajectory prediction and fan are render-side caches of the GLUT thread.
+
 // ========== ROCKET VARIABLES ==========
 extern float rocketX, rocketY;
 extern float rocketVelocity;
@@ -30,6 +42,17 @@ extern bool stage2Falling;
 extern float stage1FallTime;
 extern float stage2FallTime;
 
+// Integration settings
+extern IntegratorType currentIntegrator;
+extern float simulationStep;
+extern unsigned long simulationTick;
+extern unsigned long long simulationRandomCounter; // nextRandom stream (particle_rng.h)
+
+// Time warp
+extern int timeWarpLevel;
+extern bool visualEffectsEnabled;
+extern int flightEventCount;
+
 // ========== CAMERA VARIABLES ==========
 extern float cameraZoom;
 extern float cameraX, cameraY;
@@ -54,14 +77,18 @@ extern float windDirection;
 extern bool showStats;
 extern bool showGrid;
 extern bool showTrajectory;
-extern std::vector<std::pair<float, float>> trajectoryPoints;
+extern TrajectoryHistory trajectoryHistory;
+extern TrajectoryPrediction trajectoryPrediction;
+extern TrajectoryFan trajectoryFan;
 
 // ========== GAME STATE ==========
 extern GameState currentState;
 
 // ========== COLLECTIONS ==========
-extern std::vector<Star> stars;
+extern Starfield starfield;
+extern Terrain terrain;
 extern std::vector<SmokeParticle> smokeParticles;
+extern unsigned int nextParticleId;
 extern std::vector<Cloud> clouds;
 extern std::vector<ExplosionParticle> explosionParticles;
 extern std::vector<Satellite> satellites;
@@ -72,6 +99,12 @@ extern float targetAltitude;
 extern float targetVelocity;
 extern bool missionSuccess;
 
+// ========== SCENARIO ==========
+// Start conditions of the run. Loaded on the GLUT thread before the
+// simulation thread starts; part of the simulation state from then on, so
+// a checkpoint restores the scenario it ran.
+extern ScenarioConfig scenario;
+
 // ========== KEYBOARD TRACKING ==========
 extern bool keys[256];
 
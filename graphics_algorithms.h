@@ -17,6 +17,9 @@ inline int iround(float x) {
     return static_cast<int>(x + 0.5f);
 }
 
+// The draw*() functions below are the GL instantiations of the sink-generic
+// rasterizers in rasterizer.h; other backends use those templates directly.
+
 // Set pixel functions (declarations only)
 void setPixel(int x, int y);
 void setPixel(float x, float y);
@@ -50,6 +53,7 @@ void drawTriangleFanDDA(float centerX, float centerY,
 void drawQuadStripDDA(const std::vector<std::pair<float, float>>& vertices);
 void drawFilledPolygonDDA(const std::vector<std::pair<float, float>>& vertices);
 void drawEllipseMidpoint(int xc, int yc, int rx, int ry);
+void drawFilledEllipseMidpoint(int xc, int yc, int rx, int ry);
 
 // ================== SAFE HELPER FUNCTIONS (FOR RESOLVING AMBIGUITY) ==================
 // These resolve overload ambiguity when calling with integer literals
@@ -187,24 +187,24 @@ void drawThirdStage(float yOffset) {
     }
 }
 
-void drawRocket() {
-    if (rocketExploded) return;
+void drawRocket(const SimulationSnapshot& state) {
+    if (state.rocketExploded) return;
     
     // Draw separated stages if they exist
-    if (stage1Separated && stage1.falling) {
-        drawSeparatedStage(stage1, 1);
+    if (state.stage1Separated && state.stage1.falling) {
+        drawSeparatedStage(state.stage1, 1);
     }
-    if (stage2Separated && stage2.falling) {
-        drawSeparatedStage(stage2, 2);
+    if (state.stage2Separated && state.stage2.falling) {
+        drawSeparatedStage(state.stage2, 2);
     }
     
     // Draw current active rocket
     glPushMatrix();
-    glTranslatef(rocketX, rocketY, 0);
-    glRotatef(rocketAngle, 0, 0, 1);
+    glTranslatef(state.rocketX, state.rocketY, 0);
+    glRotatef(state.rocketAngle, 0, 0, 1);
     
     // IMPORTANT: Only draw the CURRENT active stage
-    if (rocketStage == 1) {
+    if (state.rocketStage == 1) {
         // Draw all three stages together when stage 1 is active
         // Adjust positions to eliminate gaps
         drawFirstStage();
@@ -212,51 +212,51 @@ void drawRocket() {
         drawThirdStage(218.0f);  // Changed from 220.0f to 218.0f (2 pixels up)
         
         // Draw stage 1 flames (ORANGE)
-        if (rocketLaunching && rocketFuel > 0) {
-            drawFlamesForStage(1);
+        if (state.rocketLaunching && state.rocketFuel > 0) {
+            drawFlamesForStage(state, 1);
         }
     } 
-    else if (rocketStage == 2) {
+    else if (state.rocketStage == 2) {
         // IMPORTANT: When stage 2 is active, we should NOT draw stage 1
         // Draw stage 2 (at position 0) and stage 3 (at offset 68)
         drawSecondStage(0.0f);
         drawThirdStage(68.0f); // Changed from 70.0f to 68.0f (2 pixels up)
         
         // Draw stage 2 flames (BLUE)
-        if (rocketLaunching && rocketFuel > 0) {
-            drawFlamesForStage(2);
+        if (state.rocketLaunching && state.rocketFuel > 0) {
+            drawFlamesForStage(state, 2);
         }
     }
-    else if (rocketStage == 3) {
+    else if (state.rocketStage == 3) {
         // IMPORTANT: When stage 3 (PAYLOAD) is active, draw ONLY the payload
         // Payload should be at position 0 (it's now the main rocket)
         drawThirdStage(0.0f);
         
         // Draw payload flames (PURPLE) - make it BRIGHTER
-        if (rocketLaunching && rocketFuel > 0) {
-            drawFlamesForStage(3);
+        if (state.rocketLaunching && state.rocketFuel > 0) {
+            drawFlamesForStage(state, 3);
         }
     }
     
     glPopMatrix();
 }
 
-void drawFlames() {
-    if (!rocketLaunching && !rocketLaunched) return;
-    if (rocketFuel <= 0) return;
+void drawFlames(const SimulationSnapshot& state) {
+    if (!state.rocketLaunching && !state.rocketLaunched) return;
+    if (state.rocketFuel <= 0) return;
     
     // Only draw flames for active rocket, not separated stages
     glPushMatrix();
-    glTranslatef(rocketX, rocketY, 0);
-    glRotatef(rocketAngle, 0, 0, 1);
+    glTranslatef(state.rocketX, state.rocketY, 0);
+    glRotatef(state.rocketAngle, 0, 0, 1);
     
     float time = glutGet(GLUT_ELAPSED_TIME) * 0.001f;
     
     // Only draw main engine if we have fuel
-    if (rocketFuel > 0) {
+    if (state.rocketFuel > 0) {
         // Main engine flame - Brighter
         for(int layer = 0; layer < 3; layer++) {
-            float layerSize = flameSize * (1.0f - layer * 0.3f);
+            float layerSize = state.flameSize * (1.0f - layer * 0.3f);
             float layerOffset = layer * 5.0f;
             
             if (layer == 0) glColor3f(1.0f, 0.4f, 0.0f); // Brighter orange
@@ -279,7 +279,7 @@ void drawFlames() {
     }
     
     // Side boosters (only for stage 1 and if it hasn't separated)
-    if (rocketStage == 1 && !stage1Separated && rocketFuel > 0) {
+    if (state.rocketStage == 1 && !state.stage1Separated && state.rocketFuel > 0) {
         for(int i = -1; i <= 1; i += 2) {
             glPushMatrix();
             glTranslatef(i * 25, 0, 0);
@@ -288,7 +288,7 @@ void drawFlames() {
             glBegin(GL_TRIANGLES);
             glVertex2f(-5, 0);
             glVertex2f(5, 0);
-            glVertex2f(0, -flameSize * 0.7f);
+            glVertex2f(0, -state.flameSize * 0.7f);
             glEnd();
             
             glPopMatrix();
@@ -298,16 +298,16 @@ void drawFlames() {
     glPopMatrix();
 }
 
-void drawFlamesForStage(int stageNum) {
-    if (!rocketLaunching || rocketFuel <= 0) return;
+void drawFlamesForStage(const SimulationSnapshot& state, int stageNum) {
+    if (!state.rocketLaunching || state.rocketFuel <= 0) return;
     
     float time = glutGet(GLUT_ELAPSED_TIME) * 0.001f;
     
     if (stageNum == 1) {
         // Stage 1 flames - ORANGE/RED (strong)
         glPushMatrix();
-        glTranslatef(rocketX, rocketY, 0);
-        glRotatef(rocketAngle, 0, 0, 1);
+        glTranslatef(state.rocketX, state.rocketY, 0);
+        glRotatef(state.rocketAngle, 0, 0, 1);
         
         for(int layer = 0; layer < 3; layer++) {
             float layerSize = 40.0f * (1.0f - layer * 0.3f);
@@ -333,8 +333,8 @@ void drawFlamesForStage(int stageNum) {
     else if (stageNum == 2) {
         // Stage 2 flames - BLUE/WHITE
         glPushMatrix();
-        glTranslatef(rocketX, rocketY, 0);
-        glRotatef(rocketAngle, 0, 0, 1);
+        glTranslatef(state.rocketX, state.rocketY, 0);
+        glRotatef(state.rocketAngle, 0, 0, 1);
         
         for(int layer = 0; layer < 2; layer++) {
             float layerSize = 25.0f * (1.0f - layer * 0.3f);
@@ -359,8 +359,8 @@ void drawFlamesForStage(int stageNum) {
     else if (stageNum == 3) {
         // Stage 3 (PAYLOAD) flames - BRIGHT PURPLE (make it more visible!)
         glPushMatrix();
-        glTranslatef(rocketX, rocketY, 0);
-        glRotatef(rocketAngle, 0, 0, 1);
+        glTranslatef(state.rocketX, state.rocketY, 0);
+        glRotatef(state.rocketAngle, 0, 0, 1);
         
         // Make payload flame BRIGHTER and larger
         for(int layer = 0; layer < 2; layer++) {
@@ -402,19 +402,31 @@ void drawFlamesForStage(int stageNum) {
     }
 }
 
-void drawStars() {
-    glPointSize(2.0f);
-    glBegin(GL_POINTS);
-    for(const auto& star : stars) {
-        float brightness = star.brightness * (1.0f - dayTime * 0.8f);
-        glColor3f(brightness, brightness, brightness);
-        glVertex2f(star.x, star.y);
-    }
-    glEnd();
-    
-    // Draw constellations
+// Stars fade out completely in full daylight (the DAY part of the cycle)
+static float starDaylightFade(const SimulationSnapshot& state) {
+    const float dayStart = 0.5f;
+    const float dayEnd = 0.75f;
+    float intoDay = std::min(state.dayTime - dayStart, dayEnd - state.dayTime);
+    if (intoDay <= 0.0f) return 1.0f;
+    if (intoDay >= STARFIELD_DAYLIGHT_RAMP) return 0.0f;
+    return 1.0f - intoDay / STARFIELD_DAYLIGHT_RAMP;
+}
+
+void drawStars(const SimulationSnapshot& state) {
+    // Twinkle follows the wall clock of the render thread
+    starfield.time = glutGet(GLUT_ELAPSED_TIME) * 0.001f;
+    
+    // Visible world rectangle (with a small margin for shake and point size)
+    float halfWidth = 400.0f / state.cameraZoom + 4.0f;
+    float halfHeight = 300.0f / state.cameraZoom + 4.0f;
+    float dayFactor = (1.0f - state.dayTime * 0.8f) * starDaylightFade(state);
+    drawStarfield(starfield, state.cameraX - halfWidth, state.cameraY - halfHeight,
+                  state.cameraX + halfWidth, state.cameraY + halfHeight, getLodPixelScale(), dayFactor);
+    
+    // Draw constellations (one batch for all lines)
     glColor3f(0.8f, 0.8f, 1.0f);
     glLineWidth(1.0f);
+    beginRasterBatch();
     // Big Dipper using Bresenham
     drawLineBresenhamSafe(100, 550, 120, 530);
     drawLineBresenhamSafe(120, 530, 140, 540);
@@ -423,12 +435,13 @@ void drawStars() {
     // Orion's Belt using Bresenham
     drawLineBresenhamSafe(600, 500, 620, 490);
     drawLineBresenhamSafe(620, 490, 640, 480);
+    endRasterBatch();
 }
 
-void drawSky() {
+void drawSky(const SimulationSnapshot& state) {
     // Sky background using OpenGL (keep this as is since it's gradient)
     glBegin(GL_QUADS);
-    if (dayTime < 0.25f) { // Night - DARKER for better contrast
+    if (state.dayTime < 0.25f) { // Night - DARKER for better contrast
         glColor3f(0.0f, 0.02f, 0.1f);
         glVertex2f(0, 600);
         glVertex2f(800, 600);
@@ -436,7 +449,7 @@ void drawSky() {
         glVertex2f(800, 0);
         glVertex2f(0, 0);
     }
-    else if (dayTime < 0.5f) { // Dawn
+    else if (state.dayTime < 0.5f) { // Dawn
         glColor3f(0.3f, 0.2f, 0.5f);
         glVertex2f(0, 600);
         glVertex2f(800, 600);
@@ -444,7 +457,7 @@ void drawSky() {
         glVertex2f(800, 0);
         glVertex2f(0, 0);
     }
-    else if (dayTime < 0.75f) { // Day - LIGHTER for better contrast
+    else if (state.dayTime < 0.75f) { // Day - LIGHTER for better contrast
         glColor3f(0.5f, 0.7f, 1.0f);
         glVertex2f(0, 600);
         glVertex2f(800, 600);
@@ -462,14 +475,15 @@ void drawSky() {
     }
     glEnd();
     
-    // Draw sun/moon
+    // Draw sun/moon (the rasterized parts share one batch)
     glPushMatrix();
     float sunX = 700;
     float sunY = 500;
     
-    if (dayTime < 0.5f) { // Moon at night
+    if (state.dayTime < 0.5f) { // Moon at night
         glColor3f(0.95f, 0.95f, 0.95f); // Brighter moon
         glTranslatef(sunX, sunY, 0);
+        beginRasterBatch();
         
         // Draw moon using midpoint algorithm
         drawFilledCircleMidpointSafe(0, 0, 20);
@@ -480,10 +494,12 @@ void drawSky() {
         drawFilledCircleMidpointSafe(-8, 8, 4);     // Left top crater
         drawFilledCircleMidpointSafe(-5, -10, 6);   // Left bottom crater
         drawFilledCircleMidpointSafe(12, -8, 3);    // Right bottom small crater
+        endRasterBatch();
         
     } else { // Sun during day
         glColor3f(1.0f, 0.95f, 0.1f); // Brighter sun
         glTranslatef(sunX, sunY, 0);
+        beginRasterBatch();
         
         // Draw sun using midpoint algorithm
         drawFilledCircleMidpointSafe(0, 0, 30);
@@ -508,25 +524,18 @@ void drawSky() {
         drawFilledCircleMidpointSafe(15, 15, 8);   // Top right flare
         drawFilledCircleMidpointSafe(-20, -15, 6); // Bottom left flare
         drawFilledCircleMidpointSafe(-10, 20, 5);  // Top left small flare
+        endRasterBatch();
     }
     
     glPopMatrix();
 }
 
-void drawGround() {
-    // Terrain with hills
+void drawGround(const SimulationSnapshot& state) {
+    // Terrain with hills, streamed in around the visible range
+    float halfWidth = 400.0f / state.cameraZoom + TERRAIN_SAMPLE_SPACING;
+    float viewBottom = state.cameraY - 300.0f / state.cameraZoom;
     glColor3f(0.15f, 0.5f, 0.15f); // Brighter green
-    glBegin(GL_POLYGON);
-    glVertex2f(0, 0);
-    glVertex2f(800, 0);
-    
-    // Create hilly terrain
-    for(int x = 0; x <= 800; x += 20) {
-        float height = 120 + 30 * sin(x * 0.02f) + 20 * sin(x * 0.05f);
-        glVertex2f(x, height);
-    }
-    glVertex2f(0, 120);
-    glEnd();
+    drawTerrain(terrain, state.cameraX - halfWidth, state.cameraX + halfWidth, std::min(0.0f, viewBottom));
     
     // Draw runway
     glColor3f(0.4f, 0.4f, 0.4f); // Brighter gray
@@ -549,9 +558,9 @@ void drawGround() {
     }
 }
 
-void drawLaunchPad() {
+void drawLaunchPad(const SimulationSnapshot& state) {
     // FIXED launch pad position - NOT relative to rocket position
-    float launchPadX = 400.0f;  // Fixed position
+    float launchPadX = state.scenario.launchPadX;  // Fixed position
     float launchPadY = 150.0f;  // Fixed position
     
     // ===== MAIN LAUNCH TABLE =====
@@ -703,22 +712,24 @@ void drawLaunchPad() {
     glEnd();
 }
 
-void drawLaunchComplex() {
+void drawLaunchComplex(const SimulationSnapshot& state) {
     // Draw main launch pad
-    drawLaunchPad();
+    drawLaunchPad(state);
     
     // FIXED positions for infrastructure
-    float launchPadX = 400.0f;
+    float launchPadX = state.scenario.launchPadX;
     float launchPadY = 150.0f;
     
     // ===== LIQUID PROPELLANT STORAGE TANKS =====
     // LOX Tank (light blue)
     float loxX = launchPadX - 180;
+    // Tank outline segments follow the on-screen size (36 at full zoom)
+    int tankSegments = lodCircleSegments(50.0f, 8, 36, 2);
     glColor3f(0.7f, 0.9f, 1.0f); // Light blue for LOX
     // Tank body
     glBegin(GL_POLYGON);
-    for(int i = 0; i < 360; i += 10) {
-        float angle = i * 3.14159f / 180.0f;
+    for(int i = 0; i < tankSegments; i++) {
+        float angle = i * 2.0f * 3.14159f / tankSegments;
         glVertex2f(loxX + 25 * cos(angle), 180 + 50 * sin(angle));
     }
     glEnd();
@@ -726,8 +737,8 @@ void drawLaunchComplex() {
     // Tank dome
     glColor3f(0.8f, 0.95f, 1.0f);
     glBegin(GL_POLYGON);
-    for(int i = 0; i < 180; i += 10) {
-        float angle = i * 3.14159f / 180.0f;
+    for(int i = 0; i < tankSegments / 2; i++) {
+        float angle = i * 2.0f * 3.14159f / tankSegments;
         glVertex2f(loxX + 25 * cos(angle), 230 + 15 * sin(angle));
     }
     glEnd();
@@ -745,8 +756,8 @@ void drawLaunchComplex() {
     glColor3f(0.8f, 0.8f, 0.8f); // Gray for methane
     // Tank body
     glBegin(GL_POLYGON);
-    for(int i = 0; i < 360; i += 10) {
-        float angle = i * 3.14159f / 180.0f;
+    for(int i = 0; i < tankSegments; i++) {
+        float angle = i * 2.0f * 3.14159f / tankSegments;
         glVertex2f(ch4X + 25 * cos(angle), 180 + 50 * sin(angle));
     }
     glEnd();
@@ -763,8 +774,8 @@ void drawLaunchComplex() {
     // Tank dome
     glColor3f(0.9f, 0.9f, 0.9f);
     glBegin(GL_POLYGON);
-    for(int i = 0; i < 180; i += 10) {
-        float angle = i * 3.14159f / 180.0f;
+    for(int i = 0; i < tankSegments / 2; i++) {
+        float angle = i * 2.0f * 3.14159f / tankSegments;
         glVertex2f(ch4X + 25 * cos(angle), 230 + 15 * sin(angle));
     }
     glEnd();
@@ -826,9 +837,10 @@ void drawLaunchComplex() {
     
     // Water tank
     glColor3f(0.3f, 0.5f, 0.9f); // Blue for water
+    int waterSegments = lodCircleSegments(25.0f, 8, 36, 2);
     glBegin(GL_POLYGON);
-    for(int i = 0; i < 360; i += 10) {
-        float angle = i * 3.14159f / 180.0f;
+    for(int i = 0; i < waterSegments; i++) {
+        float angle = i * 2.0f * 3.14159f / waterSegments;
         glVertex2f(waterTowerX + 20 * cos(angle), 280 + 25 * sin(angle));
     }
     glEnd();
@@ -1099,8 +1111,8 @@ void drawControlTower() {
     }
 }
 
-void drawGrid() {
-    if (!showGrid) return;
+void drawGrid(const SimulationSnapshot& state) {
+    if (!state.showGrid) return;
     
     glColor4f(0.4f, 0.4f, 0.4f, 0.4f); // Brighter grid
     glLineWidth(1.0f);
@@ -1122,12 +1134,23 @@ void drawGrid() {
     }
 }
 
-void drawClouds() {
+void drawClouds(const SimulationSnapshot& state) {
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
-    for(const auto& cloud : clouds) {
-        glColor4f(1.0f, 1.0f, 1.0f, cloud.opacity * (0.4f + 0.6f * dayTime)); // More opaque
+    for(const auto& cloud : state.clouds) {
+        glColor4f(1.0f, 1.0f, 1.0f, cloud.opacity * (0.4f + 0.6f * state.dayTime)); // More opaque
+        
+        // Distant clouds collapse to a single point
+        if (lodUsePoint(cloud.size)) {
+            glBegin(GL_POINTS);
+            glVertex2f(cloud.x, cloud.y);
+            glEnd();
+            continue;
+        }
+        
+        // Lobe outline follows the on-screen size (25 vertices at full zoom)
+        int segments = lodCircleSegments(cloud.size, 6, 24);
         
         // Draw cloud as multiple overlapping circles
         for(int i = 0; i < 3; i++) {
@@ -1135,7 +1158,8 @@ void drawClouds() {
             float offsetY = (i % 2 == 0) ? cloud.size * 0.2f : -cloud.size * 0.2f;
             
             glBegin(GL_TRIANGLE_FAN);
-            for(int j = 0; j <= 360; j += 15) {
+            for(int k = 0; k <= segments; k++) {
+                float j = k * 360.0f / segments;
                 float angle = j * 3.14159f / 180.0f;
                 float radius = cloud.size * (0.6f + 0.4f * sin(j * 0.1f));
                 glVertex2f(cloud.x + offsetX + radius * cos(angle), 
@@ -1148,8 +1172,8 @@ void drawClouds() {
     glDisable(GL_BLEND);
 }
 
-void drawSatellites() {
-    for(const auto& satellite : satellites) {
+void drawSatellites(const SimulationSnapshot& state) {
+    for(const auto& satellite : state.satellites) {
         glPushMatrix();
         glTranslatef(satellite.x, satellite.y, 0);
         glRotatef(satellite.angle, 0, 0, 1);
@@ -1184,13 +1208,22 @@ void drawSatellites() {
     }
 }
 
-void drawMeteors() {
-    for(const auto& meteor : meteors) {
+void drawMeteors(const SimulationSnapshot& state) {
+    for(const auto& meteor : state.meteors) {
         // Meteor body - Brighter
         glColor3f(0.9f, 0.5f, 0.2f);
+        if (lodUsePoint(meteor.size * 2)) {
+            // Sub-pixel meteor: body and glow reduce to one point
+            glBegin(GL_POINTS);
+            glVertex2f(meteor.x, meteor.y);
+            glEnd();
+            continue;
+        }
+        
+        int segments = lodCircleSegments(meteor.size * 2, 6, 12);
         glBegin(GL_POLYGON);
-        for(int i = 0; i < 360; i += 30) {
-            float angle = i * 3.14159f / 180.0f;
+        for(int i = 0; i < segments; i++) {
+            float angle = i * 2.0f * 3.14159f / segments;
             glVertex2f(meteor.x + meteor.size * cos(angle), 
                       meteor.y + meteor.size * sin(angle));
         }
@@ -1202,8 +1235,8 @@ void drawMeteors() {
         glColor4f(1.0f, 0.7f, 0.3f, 0.6f); // Brighter
         glBegin(GL_TRIANGLE_FAN);
         glVertex2f(meteor.x, meteor.y);
-        for(int i = 0; i <= 360; i += 30) {
-            float angle = i * 3.14159f / 180.0f;
+        for(int i = 0; i <= segments; i++) {
+            float angle = i * 2.0f * 3.14159f / segments;
             glVertex2f(meteor.x + meteor.size * 2 * cos(angle), 
                       meteor.y + meteor.size * 2 * sin(angle));
         }
@@ -1215,86 +1248,109 @@ void drawMeteors() {
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
         glColor4f(0.9f, 0.5f, 0.2f, 0.4f); // Brighter
         glBegin(GL_QUAD_STRIP);
-        for(size_t i = 0; i < meteor.trailX.size(); i++) {
-            float ratio = float(i) / meteor.trailX.size();
+        for(int i = 0; i < meteor.trailCount; i++) {
+            int index = meteorTrailIndex(meteor, i);
+            float ratio = float(i) / meteor.trailCount;
             float trailWidth = meteor.size * (1.0f - ratio);
-            glVertex2f(meteor.trailX[i] - trailWidth, meteor.trailY[i]);
-            glVertex2f(meteor.trailX[i] + trailWidth, meteor.trailY[i]);
+            glVertex2f(meteor.trailX[index] - trailWidth, meteor.trailY[index]);
+            glVertex2f(meteor.trailX[index] + trailWidth, meteor.trailY[index]);
         }
         glEnd();
         glDisable(GL_BLEND);
     }
 }
 
-void drawTrajectory() {
-    if (!showTrajectory) return;
+void drawTrajectory(const SimulationSnapshot& state) {
+    if (!state.showTrajectory) return;
     
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     // Draw recorded trajectory line if we have points
-    if (trajectoryPoints.size() >= 2) {
+    if (state.trajectoryHistory.count >= 2) {
         glColor4f(0.0f, 1.0f, 0.0f, 0.8f); // Brighter green
         glLineWidth(2.0f);
         glBegin(GL_LINE_STRIP);
-        for(const auto& point : trajectoryPoints) {
-            glVertex2f(point.first, point.second);
-        }
+        drawTrajectoryHistory(state.trajectoryHistory, getLodPixelScale(), TRAJECTORY_DRAW_PIXEL_SPACING);
         // Add current position if rocket exists
-        if (!rocketExploded) {
-            glVertex2f(rocketX, rocketY);
+        if (!state.rocketExploded) {
+            glVertex2f(state.rocketX, state.rocketY);
         }
         glEnd();
-    } else if (!rocketLaunching && !rocketLaunched) {
+    } else if (!state.rocketLaunching && !state.rocketLaunched) {
         // Draw starting point
         glColor4f(0.0f, 1.0f, 0.0f, 0.8f);
         glPointSize(6.0f); // Larger
         glBegin(GL_POINTS);
-        glVertex2f(rocketX, rocketY);
+        glVertex2f(state.rocketX, state.rocketY);
         glEnd();
     }
     
-    // Always draw predicted trajectory when trajectory is enabled
-    glColor4f(1.0f, 1.0f, 0.0f, 0.6f); // Brighter yellow
-    glLineWidth(1.5f);
-    glBegin(GL_LINE_STRIP);
-    
-    float predX = rocketX;
-    float predY = rocketY;
-    float predVx = 0;
-    float predVy = rocketVelocity;
-    
-    // If not launching, show trajectory with thrust
-    if (!rocketLaunching && !rocketLaunched && !rocketExploded) {
-        predVy = 0.5f; // Initial thrust
+    // Fan of paths for the manual thrust inputs (arrow keys) while they apply
+    if (!state.rocketExploded && state.rocketLaunching && state.rocketFuel > 0) {
+        predictTrajectoryFan(trajectoryFan, snapshotFlightState(state),
+                             snapshotFlightConditions(state), TRAJECTORY_FAN_CANDIDATES);
+        
+        glLineWidth(1.0f);
+        for (int c = 0; c < trajectoryFan.candidateCount; c++) {
+            int taps = trajectoryFan.thrustTaps[c];
+            float fade = 0.3f / (taps > 0 ? taps : -taps); // Fainter for bigger corrections
+            if (taps > 0) {
+                glColor4f(0.4f, 1.0f, 1.0f, fade); // More thrust: cyan
+            } else {
+                glColor4f(1.0f, 0.6f, 0.2f, fade); // Less thrust: orange
+            }
+            glBegin(GL_LINE_STRIP);
+            glVertex2f(state.rocketX, state.rocketY);
+            for (int i = 0; i < trajectoryFan.pointCount[c]; i++) {
+                glVertex2f(trajectoryFan.x[c][i], trajectoryFan.y[c][i]);
+            }
+            glEnd();
+        }
     }
     
-    for(int i = 0; i < 100; i++) {
-        if (rocketLaunching && rocketFuel > 0 && i < 20) {
-            predVy += 0.08f; // Thrust while fuel lasts
-        } else {
-            predVy -= 0.05f; // Gravity
-        }
-        predX += predVx + windSpeed * windDirection * 0.1f; // Wind effect
-        predY += predVy;
-        glVertex2f(predX, predY);
+    // Always draw predicted trajectory when trajectory is enabled
+    if (!state.rocketExploded) {
+        bool launchPreview = !state.rocketLaunching && !state.rocketLaunched;
+        updateTrajectoryPrediction(trajectoryPrediction, snapshotFlightState(state),
+                                   snapshotFlightConditions(state), state.simulationTick, launchPreview);
+        
+        glColor4f(1.0f, 1.0f, 0.0f, 0.6f); // Brighter yellow
+        glLineWidth(1.5f);
+        glBegin(GL_LINE_STRIP);
+        glVertex2f(state.rocketX, state.rocketY);
         
-        if (predY < 0 || predY > 800) break;
+        // Skip points that would land closer together than a few pixels
+        float pixelScale = getLodPixelScale();
+        float minSpacing = TRAJECTORY_DRAW_PIXEL_SPACING / (pixelScale > 0.0f ? pixelScale : 1.0f);
+        float lastX = state.rocketX;
+        float lastY = state.rocketY;
+        int last = trajectoryPrediction.count - 1;
+        for (int i = 0; i <= last; i++) {
+            const RocketFlightState& point = predictedPoint(trajectoryPrediction, i);
+            float dx = point.x - lastX;
+            float dy = point.y - lastY;
+            if (i == last || dx * dx + dy * dy >= minSpacing * minSpacing) {
+                glVertex2f(point.x, point.y);
+                lastX = point.x;
+                lastY = point.y;
+            }
+        }
+        glEnd();
     }
-    glEnd();
     
     glDisable(GL_BLEND);
 }
 
-void drawSmoke() {
-    if (smokeParticles.empty()) return;
+void drawSmoke(const SimulationSnapshot& state) {
+    if (state.smokeParticles.empty()) return;
     
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     float time = glutGet(GLUT_ELAPSED_TIME) * 0.001f;
     
-    for(const auto& smoke : smokeParticles) {
+    for(const auto& smoke : state.smokeParticles) {
         // Calculate smoke transparency based on life
         float alpha = smoke.alpha * (smoke.life / 0.5f); // Fade out as life decreases
         
@@ -1305,13 +1361,26 @@ void drawSmoke() {
         
         glColor4f(r, g, b, alpha * 0.7f); // More transparent
         
+        // Sub-pixel puffs are drawn as a single point
+        if (lodUsePoint(smoke.size * 1.5f)) {
+            glBegin(GL_POINTS);
+            glVertex2f(smoke.x, smoke.y);
+            glEnd();
+            continue;
+        }
+        
+        // Outline follows the on-screen size; a multiple of 8 keeps the
+        // puffy sections at 45 degree intervals (24 segments at full size)
+        int segments = lodCircleSegments(smoke.size, 8, 24, 8);
+        int puffEvery = segments / 8;
+        
         // Draw smoke as soft, fuzzy particles (not solid shapes)
         glBegin(GL_TRIANGLE_FAN);
         glVertex2f(smoke.x, smoke.y); // Center
         
         // Create wavy, organic smoke shape
-        for(int i = 0; i <= 360; i += 15) {
-            float angle = i * 3.14159f / 180.0f;
+        for(int i = 0; i <= segments; i++) {
+            float angle = i * 2.0f * 3.14159f / segments;
             
             // Make smoke wavy and irregular
             float wave1 = sin(time * 2.0f + angle * 3.0f) * 0.3f;
@@ -1321,7 +1390,7 @@ void drawSmoke() {
             float radius = smoke.size * (1.0f + wave1 + wave2 + wave3);
             
             // Make smoke puffier by varying radius more
-            if (i % 45 == 0) {
+            if (i % puffEvery == 0) {
                 radius *= 1.3f; // Create puffier sections
             }
             
@@ -1332,11 +1401,12 @@ void drawSmoke() {
         glEnd();
         
         // Add a second, more transparent layer for depth
+        int outerSegments = segments / 2;
         glColor4f(r * 1.2f, g * 1.2f, b * 1.2f, alpha * 0.3f); // Brighter, more transparent
         glBegin(GL_TRIANGLE_FAN);
         glVertex2f(smoke.x, smoke.y);
-        for(int i = 0; i <= 360; i += 30) {
-            float angle = i * 3.14159f / 180.0f;
+        for(int i = 0; i <= outerSegments; i++) {
+            float angle = i * 2.0f * 3.14159f / outerSegments;
             float wave = sin(time * 3.0f + angle * 4.0f) * 0.4f;
             float radius = smoke.size * 1.5f * (1.0f + wave);
             glVertex2f(smoke.x + radius * cos(angle), smoke.y + radius * sin(angle));
@@ -1345,14 +1415,14 @@ void drawSmoke() {
     }
     
     // Draw smoke trails for falling stages
-    if (stage1Separated && stage1Falling && stage1.falling) {
+    if (state.stage1Separated && state.stage1Falling && state.stage1.falling) {
         // Smoke trail for falling stage 1
         glColor4f(0.3f, 0.3f, 0.3f, 0.4f);
         glBegin(GL_QUAD_STRIP);
         for(int i = 0; i < 10; i++) {
             float ratio = i / 10.0f;
-            float trailX = stage1.x - sin(stage1.angle * 3.14159f / 180.0f) * ratio * 50.0f;
-            float trailY = stage1.y - cos(stage1.angle * 3.14159f / 180.0f) * ratio * 50.0f;
+            float trailX = state.stage1.x - sin(state.stage1.angle * 3.14159f / 180.0f) * ratio * 50.0f;
+            float trailY = state.stage1.y - cos(state.stage1.angle * 3.14159f / 180.0f) * ratio * 50.0f;
             float width = 10.0f * (1.0f - ratio);
             glVertex2f(trailX - width, trailY);
             glVertex2f(trailX + width, trailY);
@@ -1360,14 +1430,14 @@ void drawSmoke() {
         glEnd();
     }
     
-    if (stage2Separated && stage2Falling && stage2.falling) {
+    if (state.stage2Separated && state.stage2Falling && state.stage2.falling) {
         // Smoke trail for falling stage 2
         glColor4f(0.25f, 0.25f, 0.25f, 0.3f);
         glBegin(GL_QUAD_STRIP);
         for(int i = 0; i < 8; i++) {
             float ratio = i / 8.0f;
-            float trailX = stage2.x - sin(stage2.angle * 3.14159f / 180.0f) * ratio * 40.0f;
-            float trailY = stage2.y - cos(stage2.angle * 3.14159f / 180.0f) * ratio * 40.0f;
+            float trailX = state.stage2.x - sin(state.stage2.angle * 3.14159f / 180.0f) * ratio * 40.0f;
+            float trailY = state.stage2.y - cos(state.stage2.angle * 3.14159f / 180.0f) * ratio * 40.0f;
             float width = 8.0f * (1.0f - ratio);
             glVertex2f(trailX - width, trailY);
             glVertex2f(trailX + width, trailY);
@@ -1378,17 +1448,25 @@ void drawSmoke() {
     glDisable(GL_BLEND);
 }
 
-void drawExplosion() {
-    if (!rocketExploded) return;
+void drawExplosion(const SimulationSnapshot& state) {
+    if (!state.rocketExploded) return;
     
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE);
     
-    for(const auto& particle : explosionParticles) {
+    for(const auto& particle : state.explosionParticles) {
         glColor4f(particle.r, particle.g, particle.b, particle.life);
+        if (lodUsePoint(particle.size)) {
+            glBegin(GL_POINTS);
+            glVertex2f(particle.x, particle.y);
+            glEnd();
+            continue;
+        }
+        
+        int segments = lodCircleSegments(particle.size, 5, 12);
         glBegin(GL_TRIANGLE_FAN);
-        for(int i = 0; i < 360; i += 30) {
-            float angle = i * 3.14159f / 180.0f;
+        for(int i = 0; i < segments; i++) {
+            float angle = i * 2.0f * 3.14159f / segments;
             glVertex2f(particle.x + particle.size * cos(angle), 
                       particle.y + particle.size * sin(angle));
         }
@@ -1398,12 +1476,36 @@ void drawExplosion() {
     glDisable(GL_BLEND);
 }
 
+void drawText(float x, float y, const char* text) {
+    glColor3f(1.0f, 1.0f, 1.0f); // Ensure white text
+    drawTextString(x, y, text);
+}
+
 void drawText(float x, float y, const std::string& text) {
+    drawText(x, y, text.c_str());
+}
+
+// The normal separation rule of a stage, from the rule physics uses
+static TextBuffer separationConditionText(int stageNum) {
+    const StageSeparationRule& rule = STAGE_SEPARATION_RULES[stageNum - 1];
+    TextBuffer text;
+    textClear(text);
+    textAppend(text, "STAGE ");
+    textAppendInt(text, stageNum);
+    textAppend(text, " SEP: Alt>");
+    textAppendInt(text, (int)rule.normalAltitude);
+    textAppend(text, "m & Fuel<");
+    textAppendInt(text, (int)rule.normalFuel);
+    textAppend(text, "% & Vel>");
+    textAppendInt(text, (int)rule.normalVelocity);
+    textAppend(text, "m/s");
+    return text;
+}
+
+// Fixed HUD strings are laid out once and replayed from their run
+static void drawLabel(float x, float y, TextRun& run, const char* text) {
     glColor3f(1.0f, 1.0f, 1.0f); // Ensure white text
-    glRasterPos2f(x, y);
-    for (char c : text) {
-        glutBitmapCharacter(GLUT_BITMAP_9_BY_15, c);
-    }
+    drawCachedText(x, y, run, text);
 }
 
 void drawGauge(float x, float y, float value, float maxValue, const std::string& label, float r, float g, float b) {
@@ -1439,7 +1541,26 @@ void drawGauge(float x, float y, float value, float maxValue, const std::string&
     glEnd();
 }
 
-void drawUI() {
+// ========== HUD WIDGETS ==========
+// Mission progress as shown in the status bar
+static float missionProgress(const SimulationSnapshot& state) {
+    float progress = (state.altitude / state.targetAltitude) * 100.0f;
+    if (progress > 100.0f) progress = 100.0f;
+    return progress;
+}
+
+// Gauge fill in whole pixels, as drawn by drawGauge
+static int gaugeFillPixels(float value, float maxValue) {
+    float fillHeight = (value / maxValue) * 50.0f;
+    if (fillHeight > 50.0f) fillHeight = 50.0f;
+    return (int)std::floor(fillHeight + 0.5f);
+}
+
+// Each widget's cache key sits next to its builder and folds in exactly
+// the values the builder displays; fixed widgets use the bare hudKey()
+
+// Panel backgrounds
+static void buildHudPanels(const SimulationSnapshot&) {
     // Draw HUD background
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -1478,17 +1599,45 @@ void drawUI() {
     glEnd();
     
     glDisable(GL_BLEND);
+}
+
+static unsigned long long statusBarKey(const SimulationSnapshot& state) {
+    unsigned long long key = hudKey();
+    key = hudKeyAdd(key, state.currentState);
+    key = hudKeyAdd(key, state.currentState == COUNTDOWN ? state.countdown : 0);
+    key = hudKeyAdd(key, state.rocketExploded);
+    key = hudKeyAdd(key, state.missionSuccess);
+    key = hudKeyAdd(key, state.rocketLaunched);
+    key = hudKeyAdd(key, state.rocketLaunching);
+    key = hudKeyAdd(key, (int)(state.dayTime * 4.0f));
+    key = hudKeyAdd(key, state.rocketStage);
+    key = hudKeyAdd(key, state.stage1Separated);
+    key = hudKeyAdd(key, state.stage2Separated);
+    key = hudKeyAdd(key, (int)state.targetAltitude);
+    key = hudKeyAdd(key, (int)state.targetVelocity);
+    key = hudKeyAdd(key, (state.rocketLaunching || state.rocketLaunched) ? (int)missionProgress(state) : -1);
+    return key;
+}
+
+// Mission state, targets, progress and active stage
+static void buildStatusBar(const SimulationSnapshot& state) {
+    TextBuffer line;
     
     // ===== MISSION STATUS =====
-    std::string status;
-    switch(currentState) {
+    static TextRun statusRun;
+    const char* status = "";
+    TextBuffer countdownText;
+    switch(state.currentState) {
         case PRELAUNCH: 
             status = "PRELAUNCH CHECKLIST - PRESS SPACE TO START"; 
             glColor3f(1.0f, 1.0f, 0.0f); // Yellow
             break;
         case COUNTDOWN: 
-            status = "COUNTDOWN: T-" + std::to_string(countdown);
-            if (countdown <= 3) glColor3f(1.0f, 0.0f, 0.0f); // Red for last 3 seconds
+            textClear(countdownText);
+            textAppend(countdownText, "COUNTDOWN: T-");
+            textAppendInt(countdownText, state.countdown);
+            status = countdownText.text;
+            if (state.countdown <= 3) glColor3f(1.0f, 0.0f, 0.0f); // Red for last 3 seconds
             else glColor3f(1.0f, 1.0f, 0.0f); // Yellow
             break;
         case LAUNCH: 
@@ -1504,270 +1653,421 @@ void drawUI() {
             glColor3f(0.0f, 1.0f, 0.0f); // Green
             break;
     }
-    drawText(10, 580, status);
+    if (state.currentState == COUNTDOWN) {
+        drawText(10, 580, status);
+    } else {
+        drawLabel(10, 580, statusRun, status);
+    }
     
     // Draw mission success/failure message
-    if (rocketExploded) {
+    static TextRun outcomeRun;
+    if (state.rocketExploded) {
         glColor3f(1.0f, 0.0f, 0.0f); // Red
-        drawText(10, 560, "BOOSTER DESTROYED - ROCKET LANUCHED!");
-    } else if (missionSuccess) {
+        drawLabel(10, 560, outcomeRun, "BOOSTER DESTROYED - ROCKET LANUCHED!");
+    } else if (state.missionSuccess) {
         glColor3f(0.0f, 1.0f, 0.0f); // Green
-        drawText(10, 560, "MISSION ACCOMPLISHED!");
-    }
-    
-    // ===== TELEMETRY PANEL =====
-    glColor3f(1.0f, 1.0f, 1.0f);
-    drawText(610, 180, "TELEMETRY:");
-    
-    if (showStats) {
-        // Draw gauges with labels
-        drawGauge(650, 150, rocketFuel, 100.0f, "FUEL", 0.0f, 1.0f, 0.0f);
-        drawGauge(700, 150, altitude, 1000.0f, "ALT", 1.0f, 0.0f, 0.0f);
-        drawGauge(750, 150, velocity, 10.0f, "VEL", 0.0f, 0.0f, 1.0f);
-        
-        // Draw gauge values
-        glColor3f(1.0f, 1.0f, 1.0f);
-        drawText(645, 160, std::to_string((int)rocketFuel) + "%");
-        drawText(695, 160, std::to_string((int)altitude) + "m");
-        drawText(745, 160, std::to_string((int)velocity) + "m/s");
-        
-        // Additional telemetry data
-        glColor3f(1.0f, 1.0f, 0.0f);
-        drawText(610, 120, "STAGE: " + std::to_string(rocketStage));
-        
-        // Stage status in telemetry
-        if (stage1Separated) {
-            drawText(610, 105, "STAGE 1: SEPARATED");
-        } else {
-            drawText(610, 105, "STAGE 1: ATTACHED");
-        }
-        
-        if (stage2Separated) {
-            drawText(610, 90, "STAGE 2: SEPARATED");
-        } else {
-            drawText(610, 90, "STAGE 2: ATTACHED");
-        }
-        
-        // Trajectory status
-        drawText(610, 75, "TRAJECTORY: " + std::string(showTrajectory ? "ON" : "OFF"));
-        
-        // Camera status
-        drawText(610, 60, "CAMERA: " + std::string(cameraFollowRocket ? "FOLLOW" : "FIXED"));
-    }
-    
-    // ===== CONTROLS INFO (Bottom bar) =====
-    // In drawUI(), update the controls line:
-    glColor3f(1.0f, 1.0f, 0.0f);
-    drawText(10, 25, "CONTROLS: SPACE=Start  R=Reset  G=Grid  T=Trajectory/TEST  C=Camera  D=Day/Night");
-    drawText(10, 10, "          +/-=Zoom  1/2/3/4/5=Views  S=Stats  F=Fuel  P=Separate  I=Info  ESC=Exit");
-    
-    // ===== WARNINGS/ALERTS =====
-    if (rocketFuel < 20.0f && rocketLaunching && !rocketExploded) {
-        glColor3f(1.0f, 0.0f, 0.0f); // Red
-        drawText(300, 25, "LOW FUEL!");
-    }
-    
-    if (rocketAngle > 15.0f || rocketAngle < -15.0f) {
-        glColor3f(1.0f, 0.5f, 0.0f); // Orange
-        drawText(300, 10, "HIGH ANGLE DETECTED!");
+        drawLabel(10, 560, outcomeRun, "MISSION ACCOMPLISHED!");
     }
     
     // ===== MISSION TARGETS =====
-    if (currentState == PRELAUNCH || currentState == COUNTDOWN) {
+    if (state.currentState == PRELAUNCH || state.currentState == COUNTDOWN) {
         glColor3f(0.5f, 0.8f, 1.0f);
-        drawText(400, 575, "TARGET ALTITUDE: " + std::to_string((int)targetAltitude) + "m");
-        drawText(400, 560, "TARGET VELOCITY: " + std::to_string((int)targetVelocity) + "m/s");
+        textClear(line);
+        textAppend(line, "TARGET ALTITUDE: ");
+        textAppendInt(line, (int)state.targetAltitude);
+        textAppend(line, "m");
+        drawText(400, 575, line.text);
+        textClear(line);
+        textAppend(line, "TARGET VELOCITY: ");
+        textAppendInt(line, (int)state.targetVelocity);
+        textAppend(line, "m/s");
+        drawText(400, 560, line.text);
     }
     
     // ===== DAY/NIGHT INDICATOR =====
-    std::string timeOfDay;
-    if (dayTime < 0.25f) timeOfDay = "NIGHT";
-    else if (dayTime < 0.5f) timeOfDay = "DAWN";
-    else if (dayTime < 0.75f) timeOfDay = "DAY";
-    else timeOfDay = "DUSK";
+    static TextRun timeOfDayRun;
+    const char* timeOfDay;
+    if (state.dayTime < 0.25f) timeOfDay = "TIME: NIGHT";
+    else if (state.dayTime < 0.5f) timeOfDay = "TIME: DAWN";
+    else if (state.dayTime < 0.75f) timeOfDay = "TIME: DAY";
+    else timeOfDay = "TIME: DUSK";
     
     glColor3f(1.0f, 1.0f, 1.0f);
-    drawText(700, 575, "TIME: " + timeOfDay);
+    drawLabel(700, 575, timeOfDayRun, timeOfDay);
     
     // ===== ROCKET STATUS =====
-    std::string rocketStatus;
+    static TextRun rocketStatusRun;
+    const char* rocketStatus;
     glColor3f(1.0f, 1.0f, 1.0f);
-    if (rocketExploded) {
+    if (state.rocketExploded) {
         rocketStatus = "STATUS: PAYLOAD SUCCESSFULL";
         glColor3f(1.0f, 0.0f, 0.0f);
-    } else if (rocketLaunched) {
+    } else if (state.rocketLaunched) {
         rocketStatus = "STATUS: IN FLIGHT";
         glColor3f(0.0f, 1.0f, 0.0f);
-    } else if (rocketLaunching) {
+    } else if (state.rocketLaunching) {
         rocketStatus = "STATUS: LAUNCHING";
         glColor3f(1.0f, 1.0f, 0.0f);
     } else {
         rocketStatus = "STATUS: READY";
         glColor3f(0.5f, 0.5f, 1.0f);
     }
-    drawText(10, 540, rocketStatus);
-    
-    // ===== CAMERA INFO =====
-    std::string cameraModeText;
-    switch(currentCameraMode) {
-        case MODE_LAUNCH_PAD: cameraModeText = "LAUNCH PAD"; break;
-        case MODE_WIDE_VIEW: cameraModeText = "WIDE VIEW"; break;
-        case MODE_FOLLOW_ROCKET: cameraModeText = "FOLLOW ROCKET"; break;
-        case MODE_FOLLOW_STAGE1: cameraModeText = "FOLLOW STAGE 1"; break;
-        case MODE_FOLLOW_STAGE2: cameraModeText = "FOLLOW STAGE 2"; break;
-    }
-
-    glColor3f(0.5f, 1.0f, 0.5f);
-    drawText(10, 520, "CAMERA: " + cameraModeText + 
-            " Zoom=" + std::to_string(cameraZoom).substr(0, 4));
+    drawLabel(10, 540, rocketStatusRun, rocketStatus);
     
     // ===== ACTIVE STAGE INFO =====
+    static TextRun activeStageRun, flameColorRun;
     glColor3f(1.0f, 1.0f, 0.5f);
-    std::string activeStageInfo;
-    std::string flameColorInfo;
+    const char* activeStageInfo = "";
+    const char* flameColorInfo = "";
     
-    if (rocketStage == 1) {
+    if (state.rocketStage == 1) {
         activeStageInfo = "ACTIVE: STAGE 1 (BOOSTER)";
         flameColorInfo = "FLAMES: ORANGE";
-    } else if (rocketStage == 2) {
+    } else if (state.rocketStage == 2) {
         activeStageInfo = "ACTIVE: STAGE 2 (UPPER STAGE)";
         flameColorInfo = "FLAMES: BLUE";
-    } else if (rocketStage == 3) {
+    } else if (state.rocketStage == 3) {
         activeStageInfo = "ACTIVE: PAYLOAD";
         flameColorInfo = "FLAMES: PURPLE";
     }
     
-    drawText(10, 500, activeStageInfo);
-    drawText(10, 485, flameColorInfo);
+    drawLabel(10, 500, activeStageRun, activeStageInfo);
+    drawLabel(10, 485, flameColorRun, flameColorInfo);
+    
+    // ===== SEPARATION CONDITIONS =====
+    if (state.rocketLaunching && !state.rocketExploded) {
+        static TextRun sepInfoRun;
+        glColor3f(0.8f, 0.8f, 1.0f);
+        const char* sepInfo = 0;
+        
+        static const TextBuffer stage1Sep = separationConditionText(1);
+        static const TextBuffer stage2Sep = separationConditionText(2);
+        if (state.rocketStage == 1 && !state.stage1Separated) {
+            sepInfo = stage1Sep.text;
+        } else if (state.rocketStage == 2 && !state.stage2Separated) {
+            sepInfo = stage2Sep.text;
+        } else if (state.rocketStage == 3) {
+            sepInfo = "FINAL STAGE: CONTINUE TO ORBIT";
+        }
+        
+        if (sepInfo) {
+            drawLabel(400, 540, sepInfoRun, sepInfo);
+        }
+    }
+    
+    // ===== MISSION PROGRESS =====
+    if (state.rocketLaunching || state.rocketLaunched) {
+        glColor3f(1.0f, 1.0f, 0.5f);
+        float progress = missionProgress(state);
+        
+        textClear(line);
+        textAppend(line, "MISSION PROGRESS: ");
+        textAppendInt(line, (int)progress);
+        textAppend(line, "%");
+        drawText(400, 560, line.text);
+        
+        // Progress bar background
+        glColor3f(0.3f, 0.3f, 0.3f);
+        glBegin(GL_QUADS);
+        glVertex2f(400, 545);
+        glVertex2f(600, 545);
+        glVertex2f(600, 550);
+        glVertex2f(400, 550);
+        glEnd();
+        
+        // Progress bar fill
+        glColor3f(0.0f, 1.0f, 0.0f);
+        glBegin(GL_QUADS);
+        glVertex2f(400, 545);
+        glVertex2f(400 + (200.0f * progress / 100.0f), 545);
+        glVertex2f(400 + (200.0f * progress / 100.0f), 550);
+        glVertex2f(400, 550);
+        glEnd();
+    }
+}
+
+static unsigned long long flightReadoutKey(const SimulationSnapshot& state) {
+    // The zoom as printed, so sub-display changes do not rebuild
+    TextBuffer zoomText;
+    textClear(zoomText);
+    textAppendFixed(zoomText, state.cameraZoom, 2);
+    unsigned long long key = hudKey();
+    key = hudKeyAdd(key, state.currentCameraMode);
+    for (int i = 0; i < zoomText.length; i++) key = hudKeyAdd(key, zoomText.text[i]);
+    key = hudKeyAdd(key, (int)state.rocketX);
+    key = hudKeyAdd(key, (int)state.rocketY);
+    key = hudKeyAdd(key, (int)state.altitude);
+    key = hudKeyAdd(key, state.timeWarpLevel);
+    return key;
+}
+
+// Camera, position and time warp lines
+static void buildFlightReadout(const SimulationSnapshot& state) {
+    TextBuffer line;
+    
+    // ===== CAMERA INFO =====
+    const char* cameraModeText = "";
+    switch(state.currentCameraMode) {
+        case MODE_LAUNCH_PAD: cameraModeText = "LAUNCH PAD"; break;
+        case MODE_WIDE_VIEW: cameraModeText = "WIDE VIEW"; break;
+        case MODE_FOLLOW_ROCKET: cameraModeText = "FOLLOW ROCKET"; break;
+        case MODE_FOLLOW_STAGE1: cameraModeText = "FOLLOW STAGE 1"; break;
+        case MODE_FOLLOW_STAGE2: cameraModeText = "FOLLOW STAGE 2"; break;
+    }
+
+    glColor3f(0.5f, 1.0f, 0.5f);
+    textClear(line);
+    textAppend(line, "CAMERA: ");
+    textAppend(line, cameraModeText);
+    textAppend(line, " Zoom=");
+    textAppendFixed(line, state.cameraZoom, 2);
+    drawText(10, 520, line.text);
     
     // ===== ROCKET POSITION =====
     glColor3f(0.8f, 0.8f, 1.0f);
-    std::string rocketPos = "POSITION: X=" + std::to_string((int)rocketX) + 
-                           " Y=" + std::to_string((int)rocketY) + 
-                           " Alt=" + std::to_string((int)altitude) + "m";
-    drawText(10, 470, rocketPos);
+    textClear(line);
+    textAppend(line, "POSITION: X=");
+    textAppendInt(line, (int)state.rocketX);
+    textAppend(line, " Y=");
+    textAppendInt(line, (int)state.rocketY);
+    textAppend(line, " Alt=");
+    textAppendInt(line, (int)state.altitude);
+    textAppend(line, "m");
+    drawText(10, 470, line.text);
+    
+    // ===== TIME WARP =====
+    if (state.timeWarpLevel > 0) {
+        glColor3f(1.0f, 0.6f, 0.2f);
+        textClear(line);
+        textAppend(line, "TIME WARP: ");
+        textAppendInt(line, TIME_WARP_LEVELS[state.timeWarpLevel]);
+        textAppend(line, "x");
+        drawText(10, 455, line.text);
+    }
+}
+
+static unsigned long long telemetryPanelKey(const SimulationSnapshot& state) {
+    unsigned long long key = hudKey();
+    key = hudKeyAdd(key, state.showStats);
+    if (state.showStats) {
+        key = hudKeyAdd(key, (int)state.rocketFuel);
+        key = hudKeyAdd(key, (int)state.altitude);
+        key = hudKeyAdd(key, (int)state.velocity);
+        key = hudKeyAdd(key, gaugeFillPixels(state.rocketFuel, 100.0f));
+        key = hudKeyAdd(key, gaugeFillPixels(state.altitude, 1000.0f));
+        key = hudKeyAdd(key, gaugeFillPixels(state.velocity, 10.0f));
+        key = hudKeyAdd(key, state.rocketStage);
+        key = hudKeyAdd(key, state.stage1Separated);
+        key = hudKeyAdd(key, state.stage2Separated);
+        key = hudKeyAdd(key, state.showTrajectory);
+        key = hudKeyAdd(key, state.cameraFollowRocket);
+    }
+    return key;
+}
+
+// Gauges and telemetry lines (right panel)
+static void buildTelemetryPanel(const SimulationSnapshot& state) {
+    TextBuffer line;
+    
+    // ===== TELEMETRY PANEL =====
+    static TextRun telemetryRun;
+    glColor3f(1.0f, 1.0f, 1.0f);
+    drawLabel(610, 180, telemetryRun, "TELEMETRY:");
+    
+    if (state.showStats) {
+        // Draw gauges with labels
+        drawGauge(650, 150, state.rocketFuel, 100.0f, "FUEL", 0.0f, 1.0f, 0.0f);
+        drawGauge(700, 150, state.altitude, 1000.0f, "ALT", 1.0f, 0.0f, 0.0f);
+        drawGauge(750, 150, state.velocity, 10.0f, "VEL", 0.0f, 0.0f, 1.0f);
+        
+        // Draw gauge values
+        glColor3f(1.0f, 1.0f, 1.0f);
+        textClear(line);
+        textAppendInt(line, (int)state.rocketFuel);
+        textAppend(line, "%");
+        drawText(645, 160, line.text);
+        textClear(line);
+        textAppendInt(line, (int)state.altitude);
+        textAppend(line, "m");
+        drawText(695, 160, line.text);
+        textClear(line);
+        textAppendInt(line, (int)state.velocity);
+        textAppend(line, "m/s");
+        drawText(745, 160, line.text);
+        
+        // Additional telemetry data
+        glColor3f(1.0f, 1.0f, 0.0f);
+        textClear(line);
+        textAppend(line, "STAGE: ");
+        textAppendInt(line, state.rocketStage);
+        drawText(610, 120, line.text);
+        
+        // Stage status in telemetry
+        static TextRun stage1Run, stage2Run, trajectoryRun, cameraRun;
+        drawLabel(610, 105, stage1Run, state.stage1Separated ? "STAGE 1: SEPARATED" : "STAGE 1: ATTACHED");
+        drawLabel(610, 90, stage2Run, state.stage2Separated ? "STAGE 2: SEPARATED" : "STAGE 2: ATTACHED");
+        
+        // Trajectory status
+        drawLabel(610, 75, trajectoryRun, state.showTrajectory ? "TRAJECTORY: ON" : "TRAJECTORY: OFF");
+        
+        // Camera status
+        drawLabel(610, 60, cameraRun, state.cameraFollowRocket ? "CAMERA: FOLLOW" : "CAMERA: FIXED");
+    }
+}
+
+static unsigned long long stagePanelKey(const SimulationSnapshot& state) {
+    unsigned long long key = hudKey();
+    key = hudKeyAdd(key, state.stage1Separated);
+    key = hudKeyAdd(key, state.stage1.falling);
+    if (state.stage1Separated && state.stage1.falling) {
+        key = hudKeyAdd(key, state.stage1.y < 400 && state.stage1.velocity < -1.0f);
+        key = hudKeyAdd(key, (int)state.stage1.x);
+        key = hudKeyAdd(key, (int)state.stage1.y);
+        key = hudKeyAdd(key, (int)state.stage1.velocity);
+    }
+    key = hudKeyAdd(key, state.stage2Separated);
+    key = hudKeyAdd(key, state.stage2.falling);
+    if (state.stage2Separated && state.stage2.falling) {
+        key = hudKeyAdd(key, (int)state.stage2.x);
+        key = hudKeyAdd(key, (int)state.stage2.y);
+        key = hudKeyAdd(key, (int)state.stage2.velocity);
+    }
+    key = hudKeyAdd(key, state.rocketStage);
+    key = hudKeyAdd(key, state.rocketExploded);
+    return key;
+}
+
+// Stage status (left panel)
+static void buildStagePanel(const SimulationSnapshot& state) {
+    TextBuffer line;
     
     // ===== STAGE INFO PANEL (Left side) =====
+    static TextRun stagePanelRun, stage1StatusRun, stage2StatusRun, payloadStatusRun;
     glColor3f(1.0f, 1.0f, 1.0f);
-    drawText(10, 340, "=== STAGE STATUS ===");
+    drawLabel(10, 340, stagePanelRun, "=== STAGE STATUS ===");
     
     // Stage 1 status
     glColor3f(1.0f, 0.5f, 0.0f); // Orange
-    std::string stage1Status = "STAGE 1: ";
-    if (stage1Separated) {
-        if (stage1.falling) {
-            stage1Status += "FALLING ";
-            if (stage1.y < 400 && stage1.velocity < -1.0f) {
-                stage1Status += "(PARACHUTE)";
+    const char* stage1Status;
+    if (state.stage1Separated) {
+        if (state.stage1.falling) {
+            if (state.stage1.y < 400 && state.stage1.velocity < -1.0f) {
+                stage1Status = "STAGE 1: FALLING (PARACHUTE)";
+            } else {
+                stage1Status = "STAGE 1: FALLING ";
             }
         } else {
-            stage1Status += "CRASHED";
+            stage1Status = "STAGE 1: CRASHED";
         }
     } else {
-        stage1Status += "ATTACHED";
+        stage1Status = "STAGE 1: ATTACHED";
     }
-    drawText(15, 320, stage1Status);
+    drawLabel(15, 320, stage1StatusRun, stage1Status);
     
     // Stage 1 position if separated
-    if (stage1Separated && stage1.falling) {
+    if (state.stage1Separated && state.stage1.falling) {
         glColor3f(0.8f, 0.8f, 0.8f);
-        std::string stage1Pos = "  X=" + std::to_string((int)stage1.x) + 
-                               " Y=" + std::to_string((int)stage1.y) + 
-                               " V=" + std::to_string((int)stage1.velocity);
-        drawText(15, 305, stage1Pos);
+        textClear(line);
+        textAppend(line, "  X=");
+        textAppendInt(line, (int)state.stage1.x);
+        textAppend(line, " Y=");
+        textAppendInt(line, (int)state.stage1.y);
+        textAppend(line, " V=");
+        textAppendInt(line, (int)state.stage1.velocity);
+        drawText(15, 305, line.text);
     }
     
     // Stage 2 status
     glColor3f(0.5f, 1.0f, 0.5f); // Green
-    std::string stage2Status = "STAGE 2: ";
-    if (stage2Separated) {
-        if (stage2.falling) {
-            stage2Status += "FALLING";
-        } else {
-            stage2Status += "CRASHED";
-        }
+    const char* stage2Status;
+    if (state.stage2Separated) {
+        stage2Status = state.stage2.falling ? "STAGE 2: FALLING" : "STAGE 2: CRASHED";
     } else {
-        stage2Status += "ATTACHED";
+        stage2Status = "STAGE 2: ATTACHED";
     }
-    drawText(15, 285, stage2Status);
+    drawLabel(15, 285, stage2StatusRun, stage2Status);
     
     // Stage 2 position if separated
-    if (stage2Separated && stage2.falling) {
+    if (state.stage2Separated && state.stage2.falling) {
         glColor3f(0.8f, 0.8f, 0.8f);
-        std::string stage2Pos = "  X=" + std::to_string((int)stage2.x) + 
-                               " Y=" + std::to_string((int)stage2.y) + 
-                               " V=" + std::to_string((int)stage2.velocity);
-        drawText(15, 270, stage2Pos);
+        textClear(line);
+        textAppend(line, "  X=");
+        textAppendInt(line, (int)state.stage2.x);
+        textAppend(line, " Y=");
+        textAppendInt(line, (int)state.stage2.y);
+        textAppend(line, " V=");
+        textAppendInt(line, (int)state.stage2.velocity);
+        drawText(15, 270, line.text);
     }
     
     // Stage 3 (Payload) status
     glColor3f(0.8f, 0.5f, 1.0f); // Purple
-    std::string stage3Status = "PAYLOAD: ";
-    if (rocketStage == 3) {
-        stage3Status += "ACTIVE";
-    } else if (rocketExploded) {
-        stage3Status += "DESTROYED";
+    const char* stage3Status;
+    if (state.rocketStage == 3) {
+        stage3Status = "PAYLOAD: ACTIVE";
+    } else if (state.rocketExploded) {
+        stage3Status = "PAYLOAD: DESTROYED";
     } else {
-        stage3Status += "ATTACHED";
+        stage3Status = "PAYLOAD: ATTACHED";
     }
-    drawText(15, 250, stage3Status);
-    
-    // ===== SEPARATION CONDITIONS =====
-    if (rocketLaunching && !rocketExploded) {
-        glColor3f(0.8f, 0.8f, 1.0f);
-        std::string sepInfo;
-        
-        if (rocketStage == 1 && !stage1Separated) {
-            sepInfo = "STAGE 1 SEP: Alt>350m & Fuel<40% & Vel>4m/s";
-        } else if (rocketStage == 2 && !stage2Separated) {
-            sepInfo = "STAGE 2 SEP: Alt>650m & Fuel<30% & Vel>5m/s";
-        } else if (rocketStage == 3) {
-            sepInfo = "FINAL STAGE: CONTINUE TO ORBIT";
-        }
-        
-        if (!sepInfo.empty()) {
-            drawText(400, 540, sepInfo);
-        }
+    drawLabel(15, 250, payloadStatusRun, stage3Status);
+}
+
+static unsigned long long alertsKey(const SimulationSnapshot& state) {
+    unsigned long long key = hudKey();
+    key = hudKeyAdd(key, state.rocketFuel < 20.0f && state.rocketLaunching && !state.rocketExploded);
+    key = hudKeyAdd(key, state.rocketAngle > 15.0f || state.rocketAngle < -15.0f);
+    return key;
+}
+
+// Warnings
+static void buildAlerts(const SimulationSnapshot& state) {
+    // ===== WARNINGS/ALERTS =====
+    static TextRun lowFuelRun, highAngleRun;
+    if (state.rocketFuel < 20.0f && state.rocketLaunching && !state.rocketExploded) {
+        glColor3f(1.0f, 0.0f, 0.0f); // Red
+        drawLabel(300, 25, lowFuelRun, "LOW FUEL!");
     }
     
-    // ===== MISSION PROGRESS =====
-    if (rocketLaunching || rocketLaunched) {
-        glColor3f(1.0f, 1.0f, 0.5f);
-        float progress = (altitude / targetAltitude) * 100.0f;
-        if (progress > 100.0f) progress = 100.0f;
-        
-        std::string progressText = "MISSION PROGRESS: " + std::to_string((int)progress) + "%";
-        drawText(400, 560, progressText);
-        
-        // Progress bar background
-        glColor3f(0.3f, 0.3f, 0.3f);
-        glBegin(GL_QUADS);
-        glVertex2f(400, 545);
-        glVertex2f(600, 545);
-        glVertex2f(600, 550);
-        glVertex2f(400, 550);
-        glEnd();
-        
-        // Progress bar fill
-        glColor3f(0.0f, 1.0f, 0.0f);
-        glBegin(GL_QUADS);
-        glVertex2f(400, 545);
-        glVertex2f(400 + (200.0f * progress / 100.0f), 545);
-        glVertex2f(400 + (200.0f * progress / 100.0f), 550);
-        glVertex2f(400, 550);
-        glEnd();
+    if (state.rocketAngle > 15.0f || state.rocketAngle < -15.0f) {
+        glColor3f(1.0f, 0.5f, 0.0f); // Orange
+        drawLabel(300, 10, highAngleRun, "HIGH ANGLE DETECTED!");
     }
 }
 
-void drawCountdown() {
-    if (countdown <= 0) return;
+// Key help (bottom bar)
+static void buildControlsBar(const SimulationSnapshot&) {
+    // ===== CONTROLS INFO (Bottom bar) =====
+    static TextRun controlsRun1, controlsRun2;
+    glColor3f(1.0f, 1.0f, 0.0f);
+    drawLabel(10, 25, controlsRun1, "CONTROLS: SPACE=Start  R=Reset  G=Grid  T=Trajectory/TEST  C=Camera  D=Day/Night");
+    drawLabel(10, 10, controlsRun2, "          +/-=Zoom  1/2/3/4/5=Views  S=Stats  F=Fuel  P=Separate  I=Info  ESC=Exit");
+}
+
+void drawUI(const SimulationSnapshot& state) {
+    static HudWidget panels, statusBar, flightReadout, telemetryPanel, stagePanel, alerts, controlsBar;
+    
+    // The atlas upload must not end up inside a display list
+    initializeTextRendering();
+    
+    drawHudWidget(panels, hudKey(), buildHudPanels, state);
+    drawHudWidget(controlsBar, hudKey(), buildControlsBar, state);
+    drawHudWidget(statusBar, statusBarKey(state), buildStatusBar, state);
+    drawHudWidget(flightReadout, flightReadoutKey(state), buildFlightReadout, state);
+    drawHudWidget(telemetryPanel, telemetryPanelKey(state), buildTelemetryPanel, state);
+    drawHudWidget(stagePanel, stagePanelKey(state), buildStagePanel, state);
+    drawHudWidget(alerts, alertsKey(state), buildAlerts, state);
+}
+
+void drawCountdown(const SimulationSnapshot& state) {
+    if (state.countdown <= 0) return;
     
     // Draw large countdown numbers
     glColor3f(1.0f, 0.0f, 0.0f);
     glPushMatrix();
     glTranslatef(400, 300, 0);
     
-    std::string countStr = std::to_string(countdown);
+    std::string countStr = std::to_string(state.countdown);
     glRasterPos2f(-countStr.length() * 9, -5);
     for(char c : countStr) {
         glutBitmapCharacter(GLUT_BITMAP_TIMES_ROMAN_24, c);
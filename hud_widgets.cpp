@@ -0,0 +1,35 @@
+#include "hud_widgets.h"
+
+#ifdef __APPLE__
+#include <GLUT/glut.h>
+#else
+#include <GL/glut.h>
+#endif
+
+void drawHudWidget(HudWidget& widget, unsigned long long key,
+                   void (*build)(const SimulationSnapshot& state), const SimulationSnapshot& state) {
+    if (widget.valid && widget.key == key) {
+        glCallList(widget.displayList);
+        return;
+    }
+    
+    if (widget.displayList == 0) {
+        widget.displayList = glGenLists(1);
+    }
+    if (widget.displayList == 0) {
+        // No list available: draw immediately, try again next frame
+        build(state);
+        return;
+    }
+    
+    glNewList(widget.displayList, GL_COMPILE_AND_EXECUTE);
+    build(state);
+    glEndList();
+    
+    widget.key = key;
+    widget.valid = true;
+}
+
+void invalidateHudWidget(HudWidget& widget) {
+    widget.valid = false;
+}
@@ -0,0 +1,41 @@
+// hud_widgets.h
+#ifndef HUD_WIDGETS_H
+#define HUD_WIDGETS_H
+
+// ================== RETAINED HUD WIDGETS ==================
+// A widget keeps the GL commands that draw it in a display list, together
+// with a key built from the values it displays (already rounded the way
+// they are shown). While the key stays the same the list is replayed;
+// when it changes the widget's builder runs again and is re-recorded.
+struct HudWidget {
+    unsigned int displayList;
+    unsigned long long key;
+    bool valid;
+};
+
+// Keys are folded from displayed values: hudKeyAdd(hudKeyAdd(hudKey(), a), b)
+inline unsigned long long hudKey() {
+    return 14695981039346656037ULL; // FNV-1a offset basis
+}
+
+inline unsigned long long hudKeyAdd(unsigned long long key, int value) {
+    unsigned int bits = (unsigned int)value;
+    for (int i = 0; i < 4; i++) {
+        key ^= (bits >> (i * 8)) & 0xFFu;
+        key *= 1099511628211ULL; // FNV-1a prime
+    }
+    return key;
+}
+
+struct SimulationSnapshot;
+
+// Replay 'widget' if 'key' matches what it was built with, otherwise run
+// 'build' on 'state' and record it. Builders must only issue GL drawing
+// commands.
+void drawHudWidget(HudWidget& widget, unsigned long long key,
+                   void (*build)(const SimulationSnapshot& state), const SimulationSnapshot& state);
+
+// Force the next drawHudWidget to rebuild
+void invalidateHudWidget(HudWidget& widget);
+
+#endif
@@ -0,0 +1,207 @@
+#include "integrator.h"
+#include "constants_config.h"
+#include <cmath>
+
+ForceModel constantAcceleration(float acceleration) {
+    ForceModel forces;
+    forces.acceleration = acceleration;
+    forces.dragRetention = 1.0f;
+    forces.dragBelowPosition = 0.0f;
+    forces.dragBelowVelocity = 0.0f;
+    return forces;
+}
+
+ForceModel acceleratedWithDrag(float acceleration, float dragRetention,
+                               float belowPosition, float belowVelocity) {
+    ForceModel forces;
+    forces.acceleration = acceleration;
+    forces.dragRetention = dragRetention;
+    forces.dragBelowPosition = belowPosition;
+    forces.dragBelowVelocity = belowVelocity;
+    return forces;
+}
+
+static bool dragActive(const ForceModel& forces, float position, float velocity) {
+    return forces.dragRetention < 1.0f &&
+           position < forces.dragBelowPosition &&
+           velocity < forces.dragBelowVelocity;
+}
+
+// Continuous form of the force model: dv/dt = a + ln(retention) * v.
+// The drag regime is fixed for the whole step ('dragOn'); regime switches
+// are located separately so the Runge-Kutta stages never straddle one.
+static float accelerationAt(const ForceModel& forces, float velocity, bool dragOn) {
+    float a = forces.acceleration;
+    if (dragOn) {
+        a += std::log(forces.dragRetention) * velocity;
+    }
+    return a;
+}
+
+// ================== SEMI-IMPLICIT EULER ==================
+// Velocity first, then position with the new velocity, then drag.
+// At dt = 1 this is exactly the original "v += a; y += v; v *= k" tick.
+static void stepSemiImplicitEuler(MotionState& state, const ForceModel& forces, float dt) {
+    state.velocity += forces.acceleration * dt;
+    state.position += state.velocity * dt;
+    if (dragActive(forces, state.position, state.velocity)) {
+        state.velocity *= (dt == 1.0f) ? forces.dragRetention : std::pow(forces.dragRetention, dt);
+    }
+}
+
+// ================== RUNGE-KUTTA 4 ==================
+static void stepRK4(MotionState& state, const ForceModel& forces, float dt, bool dragOn) {
+    float x = state.position;
+    float v = state.velocity;
+    
+    float k1x = v;
+    float k1v = accelerationAt(forces, v, dragOn);
+    
+    float k2x = v + 0.5f * dt * k1v;
+    float k2v = accelerationAt(forces, k2x, dragOn);
+    
+    float k3x = v + 0.5f * dt * k2v;
+    float k3v = accelerationAt(forces, k3x, dragOn);
+    
+    float k4x = v + dt * k3v;
+    float k4v = accelerationAt(forces, k4x, dragOn);
+    
+    state.position = x + dt / 6.0f * (k1x + 2.0f * k2x + 2.0f * k3x + k4x);
+    state.velocity = v + dt / 6.0f * (k1v + 2.0f * k2v + 2.0f * k3v + k4v);
+}
+
+// ================== ADAPTIVE RK45 (CASH-KARP) ==================
+// One embedded step; returns the 5th order solution and the error estimate
+static float stepCashKarp(MotionState& state, const ForceModel& forces, float h, bool dragOn) {
+    static const float b21 = 0.2f;
+    static const float b31 = 3.0f / 40.0f, b32 = 9.0f / 40.0f;
+    static const float b41 = 0.3f, b42 = -0.9f, b43 = 1.2f;
+    static const float b51 = -11.0f / 54.0f, b52 = 2.5f, b53 = -70.0f / 27.0f, b54 = 35.0f / 27.0f;
+    static const float b61 = 1631.0f / 55296.0f, b62 = 175.0f / 512.0f, b63 = 575.0f / 13824.0f;
+    static const float b64 = 44275.0f / 110592.0f, b65 = 253.0f / 4096.0f;
+    static const float c1 = 37.0f / 378.0f, c3 = 250.0f / 621.0f, c4 = 125.0f / 594.0f, c6 = 512.0f / 1771.0f;
+    static const float d1 = c1 - 2825.0f / 27648.0f, d3 = c3 - 18575.0f / 48384.0f;
+    static const float d4 = c4 - 13525.0f / 55296.0f, d5 = -277.0f / 14336.0f, d6 = c6 - 0.25f;
+    
+    float x = state.position;
+    float v = state.velocity;
+    
+    // Acceleration depends only on velocity within a drag regime, so the
+    // position stages are just the velocity stages
+    float k1x = v;
+    float k1v = accelerationAt(forces, v, dragOn);
+    
+    float v2 = v + h * b21 * k1v;
+    float k2v = accelerationAt(forces, v2, dragOn);
+    
+    float v3 = v + h * (b31 * k1v + b32 * k2v);
+    float k3x = v3, k3v = accelerationAt(forces, v3, dragOn);
+    
+    float v4 = v + h * (b41 * k1v + b42 * k2v + b43 * k3v);
+    float k4x = v4, k4v = accelerationAt(forces, v4, dragOn);
+    
+    float v5 = v + h * (b51 * k1v + b52 * k2v + b53 * k3v + b54 * k4v);
+    float k5x = v5, k5v = accelerationAt(forces, v5, dragOn);
+    
+    float v6 = v + h * (b61 * k1v + b62 * k2v + b63 * k3v + b64 * k4v + b65 * k5v);
+    float k6x = v6, k6v = accelerationAt(forces, v6, dragOn);
+    
+    state.position = x + h * (c1 * k1x + c3 * k3x + c4 * k4x + c6 * k6x);
+    state.velocity = v + h * (c1 * k1v + c3 * k3v + c4 * k4v + c6 * k6v);
+    
+    float errX = h * (d1 * k1x + d3 * k3x + d4 * k4x + d5 * k5x + d6 * k6x);
+    float errV = h * (d1 * k1v + d3 * k3v + d4 * k4v + d5 * k5v + d6 * k6v);
+    return std::fmax(std::fabs(errX), std::fabs(errV));
+}
+
+static void stepRK45(MotionState& state, const ForceModel& forces, float dt, bool dragOn) {
+    float remaining = dt;
+    float h = dt;
+    
+    for (int attempt = 0; remaining > 0.0f && attempt < INTEGRATOR_MAX_SUBSTEPS; attempt++) {
+        if (h > remaining) h = remaining;
+        
+        MotionState trial = state;
+        float error = stepCashKarp(trial, forces, h, dragOn);
+        
+        if (error <= INTEGRATOR_TOLERANCE || h <= INTEGRATOR_MIN_STEP) {
+            // Accept and try to grow the step
+            state = trial;
+            remaining -= h;
+            float grow = (error > 0.0f) ? 0.9f * std::pow(INTEGRATOR_TOLERANCE / error, 0.2f) : 5.0f;
+            h *= std::fmin(5.0f, grow);
+        } else {
+            // Reject and shrink the step
+            float shrink = 0.9f * std::pow(INTEGRATOR_TOLERANCE / error, 0.25f);
+            h = std::fmax(INTEGRATOR_MIN_STEP, h * std::fmax(0.1f, shrink));
+        }
+    }
+    
+    // Out of attempts: finish the interval in one step
+    if (remaining > 0.0f) {
+        stepCashKarp(state, forces, remaining, dragOn);
+    }
+}
+
+// ================== DRAG REGIME SWITCHING ==================
+static void stepRungeKutta(MotionState& state, const ForceModel& forces, float dt,
+                           bool dragOn, IntegratorType type) {
+    if (type == INTEGRATOR_RK45) {
+        stepRK45(state, forces, dt, dragOn);
+    } else {
+        stepRK4(state, forces, dt, dragOn);
+    }
+}
+
+// Integrate with a fixed drag regime, splitting the step where the regime
+// switches (e.g. the parachute opening) so accuracy does not drop to first
+// order around the discontinuity
+static void integrateRungeKutta(MotionState& state, const ForceModel& forces, float dt, IntegratorType type) {
+    bool dragOn = dragActive(forces, state.position, state.velocity);
+    
+    MotionState trial = state;
+    stepRungeKutta(trial, forces, dt, dragOn, type);
+    if (dragActive(forces, trial.position, trial.velocity) == dragOn) {
+        state = trial;
+        return;
+    }
+    
+    // Bisect for the time at which the regime switches
+    float lo = 0.0f;
+    float hi = dt;
+    for (int i = 0; i < INTEGRATOR_EVENT_ITERATIONS; i++) {
+        float mid = 0.5f * (lo + hi);
+        MotionState probe = state;
+        stepRungeKutta(probe, forces, mid, dragOn, type);
+        if (dragActive(forces, probe.position, probe.velocity) == dragOn) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    
+    stepRungeKutta(state, forces, hi, dragOn, type);
+    stepRungeKutta(state, forces, dt - hi, !dragOn, type);
+}
+
+void integrateMotion(MotionState& state, const ForceModel& forces, float dt, IntegratorType type) {
+    switch (type) {
+        case INTEGRATOR_RK4:
+        case INTEGRATOR_RK45:
+            integrateRungeKutta(state, forces, dt, type);
+            break;
+        case INTEGRATOR_SEMI_IMPLICIT_EULER:
+        default:
+            stepSemiImplicitEuler(state, forces, dt);
+            break;
+    }
+}
+
+const char* integratorName(IntegratorType type) {
+    switch (type) {
+        case INTEGRATOR_RK4: return "RK4";
+        case INTEGRATOR_RK45: return "RK45";
+        case INTEGRATOR_SEMI_IMPLICIT_EULER:
+        default: return "EULER";
+    }
+}
@@ -0,0 +1,41 @@
+// integrator.h
+#ifndef INTEGRATOR_H
+#define INTEGRATOR_H
+
+// ================== INTEGRATION METHODS ==================
+enum IntegratorType {
+    INTEGRATOR_SEMI_IMPLICIT_EULER,  // Matches the original per-tick updates exactly at dt = 1
+    INTEGRATOR_RK4,                  // Classic fourth-order Runge-Kutta
+    INTEGRATOR_RK45                  // Adaptive Cash-Karp Runge-Kutta 4(5)
+};
+
+// Vertical motion of a body (units are world pixels and simulation ticks)
+struct MotionState {
+    float position;
+    float velocity;
+};
+
+// Constant acceleration plus an optional drag that keeps 'dragRetention' of
+// the velocity per tick (the parachute's velocity *= 0.97f). Drag only acts
+// while position < dragBelowPosition and velocity < dragBelowVelocity.
+struct ForceModel {
+    float acceleration;
+    float dragRetention;
+    float dragBelowPosition;
+    float dragBelowVelocity;
+};
+
+// Force model with constant acceleration only
+ForceModel constantAcceleration(float acceleration);
+
+// Force model with constant acceleration and conditional drag
+ForceModel acceleratedWithDrag(float acceleration, float dragRetention,
+                               float belowPosition, float belowVelocity);
+
+// Advance 'state' by 'dt' ticks using the selected method
+void integrateMotion(MotionState& state, const ForceModel& forces, float dt, IntegratorType type);
+
+// Short name for status output
+const char* integratorName(IntegratorType type);
+
+#endif
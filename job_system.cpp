@@ -0,0 +1,227 @@
+#include "job_system.h"
+#include "constants_config.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// ========== JOB POOL ==========
+struct Job {
+    JobFunction function;
+    JobCountFunction count;  // Set for parallel-for jobs (split when run)
+    void* data;
+    int begin, end;
+    int grain;
+    JobId parent;
+    std::atomic<int> unfinished;           // This job plus unfinished children
+    std::atomic<int> pendingDependencies;  // Unfinished prerequisites + 1 until submitted
+    JobId dependents[JOB_MAX_DEPENDENTS];
+    int dependentCount;
+};
+
+static Job jobPool[JOB_POOL_CAPACITY];
+static std::atomic<int> jobCount(0);
+
+static JobId allocateJob() {
+    JobId id = jobCount.fetch_add(1, std::memory_order_relaxed);
+    if (id >= JOB_POOL_CAPACITY) {
+        // A batch larger than the pool is a programming error
+        std::abort();
+    }
+    return id;
+}
+
+// ========== WORK QUEUES ==========
+// Queue 0 belongs to the submitting thread, queue i to worker i. The
+// owner works LIFO at the tail (hot data), thieves take the oldest job.
+struct WorkQueue {
+    std::mutex mutex;
+    JobId jobs[JOB_POOL_CAPACITY];
+    int head, tail;  // Ever-increasing; the ring index is the value mod capacity
+};
+
+static WorkQueue queues[JOB_MAX_WORKERS + 1];
+static thread_local int queueIndex = 0;
+
+static std::thread workers[JOB_MAX_WORKERS];
+static int workerCount = 0;
+static std::atomic<bool> workersRunning(false);
+static std::atomic<int> queuedJobs(0);
+static std::mutex wakeMutex;
+static std::condition_variable wakeWorkers;
+
+static void pushJob(JobId job) {
+    WorkQueue& queue = queues[queueIndex];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs[queue.tail % JOB_POOL_CAPACITY] = job;
+        queue.tail++;
+    }
+    queuedJobs.fetch_add(1, std::memory_order_release);
+    if (workerCount > 0) {
+        { std::lock_guard<std::mutex> lock(wakeMutex); }
+        wakeWorkers.notify_one();
+    }
+}
+
+static JobId popJob(WorkQueue& queue) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.head == queue.tail) return JOB_NONE;
+    queue.tail--;
+    return queue.jobs[queue.tail % JOB_POOL_CAPACITY];
+}
+
+static JobId stealJob(WorkQueue& queue) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.head == queue.tail) return JOB_NONE;
+    JobId job = queue.jobs[queue.head % JOB_POOL_CAPACITY];
+    queue.head++;
+    return job;
+}
+
+static JobId takeJob() {
+    JobId job = popJob(queues[queueIndex]);
+    for (int i = 1; job == JOB_NONE && i <= workerCount; i++) {
+        job = stealJob(queues[(queueIndex + i) % (workerCount + 1)]);
+    }
+    if (job != JOB_NONE) queuedJobs.fetch_sub(1, std::memory_order_acquire);
+    return job;
+}
+
+// ========== EXECUTION ==========
+static void finishJob(JobId id) {
+    // Read the links first: once 'unfinished' reaches zero, the waiting
+    // thread may already be recycling this slot
+    Job& job = jobPool[id];
+    JobId parent = job.parent;
+    int dependentCount = job.dependentCount;
+    JobId dependents[JOB_MAX_DEPENDENTS];
+    for (int i = 0; i < dependentCount; i++) {
+        dependents[i] = job.dependents[i];
+    }
+    if (job.unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    for (int i = 0; i < dependentCount; i++) {
+        if (jobPool[dependents[i]].pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            pushJob(dependents[i]);
+        }
+    }
+    if (parent != JOB_NONE) finishJob(parent);
+}
+
+static void runJob(JobId id) {
+    Job& job = jobPool[id];
+    if (job.count) {
+        // Parallel for: split into children now that the count is known
+        int total = job.count(job.data);
+        for (int begin = 0; begin < total; begin += job.grain) {
+            pushJob(createJob(job.function, job.data, begin, std::min(begin + job.grain, total), id));
+        }
+    } else if (job.function) {
+        job.function(job.data, job.begin, job.end);
+    }
+    finishJob(id);
+}
+
+static void workerLoop(int index) {
+    queueIndex = index;
+    while (workersRunning.load(std::memory_order_acquire)) {
+        JobId job = takeJob();
+        if (job != JOB_NONE) {
+            runJob(job);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeWorkers.wait(lock, [] {
+            return queuedJobs.load(std::memory_order_acquire) > 0 ||
+                   !workersRunning.load(std::memory_order_acquire);
+        });
+    }
+}
+
+// ========== PUBLIC INTERFACE ==========
+int defaultJobWorkerCount() {
+    int hardware = (int)std::thread::hardware_concurrency();
+    return std::max(0, std::min(hardware - 2, JOB_MAX_WORKERS));
+}
+
+void startJobSystem(int count) {
+    stopJobSystem();
+    queueIndex = 0;
+    workerCount = std::max(0, std::min(count, JOB_MAX_WORKERS));
+    workersRunning.store(true);
+    for (int i = 0; i < workerCount; i++) {
+        workers[i] = std::thread(workerLoop, i + 1);
+    }
+}
+
+void stopJobSystem() {
+    if (!workersRunning.exchange(false)) return;
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wakeWorkers.notify_all();
+    for (int i = 0; i < workerCount; i++) {
+        workers[i].join();
+    }
+    workerCount = 0;
+}
+
+int jobWorkerCount() {
+    return workerCount;
+}
+
+JobId createJob(JobFunction function, void* data, int begin, int end, JobId parent) {
+    JobId id = allocateJob();
+    Job& job = jobPool[id];
+    job.function = function;
+    job.count = 0;
+    job.data = data;
+    job.begin = begin;
+    job.end = end;
+    job.grain = 0;
+    job.parent = parent;
+    job.dependentCount = 0;
+    job.unfinished.store(1, std::memory_order_relaxed);
+    job.pendingDependencies.store(1, std::memory_order_relaxed);
+    if (parent != JOB_NONE) {
+        jobPool[parent].unfinished.fetch_add(1, std::memory_order_relaxed);
+    }
+    return id;
+}
+
+JobId createParallelForJob(JobFunction function, JobCountFunction count, void* data, int grain) {
+    JobId id = createJob(function, data, 0, 0);
+    jobPool[id].count = count;
+    jobPool[id].grain = std::max(1, grain);
+    return id;
+}
+
+void addJobDependency(JobId job, JobId prerequisite) {
+    Job& before = jobPool[prerequisite];
+    if (before.dependentCount == JOB_MAX_DEPENDENTS) std::abort();
+    before.dependents[before.dependentCount++] = job;
+    jobPool[job].pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+}
+
+void submitJob(JobId job) {
+    if (jobPool[job].pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        pushJob(job);
+    }
+}
+
+void waitForJob(JobId id) {
+    while (jobPool[id].unfinished.load(std::memory_order_acquire) > 0) {
+        JobId job = takeJob();
+        if (job != JOB_NONE) {
+            runJob(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void resetJobs() {
+    jobCount.store(0, std::memory_order_relaxed);
+}
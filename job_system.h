@@ -0,0 +1,53 @@
+// job_system.h
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+// ================== JOB SYSTEM ==================
+// Small work-stealing scheduler with a fixed worker pool. Every thread
+// (the submitting thread included) owns a job queue: it pushes and pops at
+// one end, idle threads steal from the other. The submitting thread helps
+// while it waits, so with zero workers everything runs serially on it, in
+// queue order (the debugging fallback).
+//
+// Jobs come from a fixed pool that is recycled with resetJobs() once a
+// batch has been waited for. Job functions run on worker threads next to
+// the simulation thread: they may only touch what is reachable from their
+// 'data' pointer.
+typedef int JobId;
+const JobId JOB_NONE = -1;
+
+typedef void (*JobFunction)(void* data, int begin, int end);
+typedef int (*JobCountFunction)(void* data);
+
+// Start 'workerCount' worker threads (0 = serial). The calling thread
+// becomes the submitting thread.
+void startJobSystem(int workerCount);
+void stopJobSystem();
+int jobWorkerCount();
+
+// Worker count to use by default: hardware threads minus the simulation
+// and render threads, capped at JOB_MAX_WORKERS
+int defaultJobWorkerCount();
+
+// 'function(data, begin, end)' as one job. If 'parent' is given, the
+// parent only counts as finished once this job has finished too.
+JobId createJob(JobFunction function, void* data, int begin, int end, JobId parent = JOB_NONE);
+
+// 'function' over [0, count(data)) in chunks of 'grain' items. The count is
+// read when the job becomes ready, so it may depend on earlier jobs.
+JobId createParallelForJob(JobFunction function, JobCountFunction count, void* data, int grain);
+
+// 'job' does not start before 'prerequisite' has finished. Add every
+// dependency of a batch before submitting any of its jobs.
+void addJobDependency(JobId job, JobId prerequisite);
+
+void submitJob(JobId job);
+
+// Run jobs on the calling thread until 'job' has finished
+void waitForJob(JobId job);
+
+// Recycle the pool. The last waited job must (transitively) depend on
+// every job created since the previous reset.
+void resetJobs();
+
+#endif
@@ -0,0 +1,35 @@
+#include "level_of_detail.h"
+#include "constants_config.h"
+#include <cmath>
+
+static float lodPixelScale = 1.0f;
+
+void setLodPixelScale(float scale) {
+    lodPixelScale = (scale > 0.0f) ? scale : 1.0f;
+}
+
+float getLodPixelScale() {
+    return lodPixelScale;
+}
+
+int lodCircleSegments(float worldRadius, int minSegments, int maxSegments, int multipleOf) {
+    float projectedRadius = std::fabs(worldRadius) * lodPixelScale;
+    float circumference = 2.0f * 3.14159f * projectedRadius;
+    int segments = static_cast<int>(std::ceil(circumference / LOD_PIXELS_PER_SEGMENT));
+    
+    if (multipleOf > 1) {
+        segments = ((segments + multipleOf - 1) / multipleOf) * multipleOf;
+    }
+    if (segments < minSegments) segments = minSegments;
+    if (segments > maxSegments) segments = maxSegments;
+    return segments;
+}
+
+bool lodUsePoint(float worldRadius) {
+    return std::fabs(worldRadius) * lodPixelScale < LOD_POINT_RADIUS;
+}
+
+int lodRasterStep() {
+    if (lodPixelScale >= 1.0f) return 1;
+    return static_cast<int>(1.0f / lodPixelScale);
+}
@@ -0,0 +1,28 @@
+// level_of_detail.h
+#ifndef LEVEL_OF_DETAIL_H
+#define LEVEL_OF_DETAIL_H
+
+// ================== PIXEL SCALE ==================
+// World units -> screen pixels for the current drawing pass.
+// display() sets this to the camera zoom for the scene and 1.0 for the HUD.
+void setLodPixelScale(float scale);
+float getLodPixelScale();
+
+// ================== ROUND PRIMITIVES ==================
+// Number of segments for a circle of the given world radius, chosen so each
+// segment spans roughly LOD_PIXELS_PER_SEGMENT pixels on screen.
+// The result is clamped to [minSegments, maxSegments] and rounded up to a
+// multiple of 'multipleOf' (useful when a shape has N-fold features).
+int lodCircleSegments(float worldRadius, int minSegments, int maxSegments, int multipleOf = 1);
+
+// True when the primitive projects below LOD_POINT_RADIUS pixels and
+// should be drawn as a single point instead of a fan
+bool lodUsePoint(float worldRadius);
+
+// ================== MIDPOINT RASTERIZERS ==================
+// Sampling step (in world units) for the integer midpoint routines.
+// At zoom >= 1 every world pixel is visited; when zoomed out, several world
+// pixels collapse into one screen pixel so the routines stride over them.
+int lodRasterStep();
+
+#endif
@@ -2,43 +2,67 @@
 
 // GLUT callback implementations
 void display() {
+    // Draw the newest frame the simulation thread has published
+    bool fresh = false;
+    const SimulationSnapshot& state = latestSnapshot(fresh);
+    if (fresh && state.scenario.starSeed && state.scenario.starSeed != starfield.seed) {
+        initializeStars(state.scenario); // A restored checkpoint's scenario picks its own sky
+    }
+    
     glClear(GL_COLOR_BUFFER_BIT);
     
+    // Level of detail follows the on-screen scale of the scene
+    float viewportScale = glutGet(GLUT_WINDOW_WIDTH) / 800.0f;
+    setLodPixelScale(state.cameraZoom * viewportScale);
+    
     // Apply camera transformations
     glPushMatrix();
     glTranslatef(400, 300, 0); // Center of screen
-    glScalef(cameraZoom, cameraZoom, 1.0f);
-    glTranslatef(-cameraX, -cameraY, 0);
+    glScalef(state.cameraZoom, state.cameraZoom, 1.0f);
+    glTranslatef(-state.cameraX, -state.cameraY, 0);
     
     // Draw scene
-    drawSky();
-    drawStars();
-    drawGrid();
-    drawGround();
-    drawLaunchComplex();
-    drawClouds();
-    drawSatellites();
-    drawMeteors();
+    drawSky(state);
+    drawStars(state);
+    drawGrid(state);
+    drawGround(state);
+    drawLaunchComplex(state);
+    drawClouds(state);
+    drawSatellites(state);
+    drawMeteors(state);
     drawControlTower();
-    drawTrajectory();
-    drawRocket();
-    drawFlames();
-    drawSmoke();
-    drawExplosion();
+    drawTrajectory(state);
+    drawRocket(state);
+    drawFlames(state);
+    drawSmoke(state);
+    drawExplosion(state);
     
     glPopMatrix();
     
     // Draw UI elements (not affected by camera)
-    drawUI();
-    if (countdown > 0 && countdown <= 10) {
-        drawCountdown();
+    setLodPixelScale(viewportScale);
+    drawUI(state);
+    if (state.countdown > 0 && state.countdown <= 10) {
+        drawCountdown(state);
+    }
+    
+    // Record the finished frame before it is swapped away
+    if (frameCaptureActive()) {
+        captureGLFrame();
     }
     
     glutSwapBuffers();
 }
 
 
+// GLUT thread: the simulation runs on its own thread, so this only paces redraws
 void timer(int value) {
+    glutPostRedisplay();
+    glutTimerFunc(SIMULATION_FRAME_MS, timer, 0);  // ~60 FPS
+}
+
+// One simulation frame (simulation thread)
+void simulationFrame() {
     // Check for continuous key presses
     static int zoomCounter = 0;
     zoomCounter++;
@@ -63,6 +87,38 @@ void timer(int value) {
         zoomCounter = 0;
     }
     
+    // Run one simulation tick per time warp step. Only the last sub-step
+    // spawns particles and animates flames; warp drops back to 1x ahead of
+    // and on stage separations so they are never skipped.
+    int substeps = TIME_WARP_LEVELS[timeWarpLevel];
+    int eventsBefore = flightEventCount;
+    for (int i = 0; i < substeps; i++) {
+        bool lastStep = (i == substeps - 1);
+        
+        if (timeWarpLevel > 0 && ticksUntilSeparation() < TIME_WARP_SEPARATION_MARGIN) {
+            std::cout << "Stage separation ahead - ";
+            setTimeWarpLevel(0);
+            lastStep = true;
+        }
+        
+        visualEffectsEnabled = lastStep;
+        stepSimulation();
+        
+        if (flightEventCount != eventsBefore) {
+            if (timeWarpLevel > 0) setTimeWarpLevel(0);
+            break;
+        }
+        if (lastStep) break;
+    }
+    visualEffectsEnabled = true;
+    
+    updateVisuals();
+}
+
+// One simulation tick (physics, countdown, events)
+void stepSimulation() {
+    simulationTick++;
+    
     // Update countdown
     if (countdown > 0 && currentState == COUNTDOWN) {
         countdown--;
@@ -81,35 +137,29 @@ void timer(int value) {
         }
     }
     
-    // Update animations
-    updateStars();
-    updateClouds();
-    updateSatellites();
-    updateMeteors();
-    updateSmoke();
-    updateExplosion();
+    // Update simulation
+    updateParticles();
     updateRocket();
-    updateCamera();
     updateDayNight();
     
+    // Change wind occasionally
+    if (simulationRandom() % 1000 == 0) {
+        windDirection *= -1.0f;
+        windSpeed = 0.05f + (simulationRandom() % 10) / 100.0f;
+    }
+}
+
+// Visual-only updates, once per rendered frame
+void updateVisuals() {
+    updateScenery();
+    updateCamera();
+    
     // Blink control tower light
     lightTimer++;
     if (lightTimer >= 15) {
         lightOn = !lightOn;
         lightTimer = 0;
     }
-    
-    // Change wind occasionally
-    if (rand() % 1000 == 0) {
-        windDirection *= -1.0f;
-        windSpeed = 0.05f + (rand() % 10) / 100.0f;
-    }
-    
-    // Redraw
-    glutPostRedisplay();
-    
-    // Call timer again
-    glutTimerFunc(16, timer, 0);  // ~60 FPS
 }
 
 void reshape(int width, int height) {
@@ -122,52 +172,78 @@ void reshape(int width, int height) {
 }
 
 
+// GLUT thread: capture and exit are handled here, everything else is
+// queued for the simulation thread
 void keyboard(unsigned char key, int x, int y) {
+    switch(key) {
+        case 'v':
+        case 'V': // Start/stop frame capture (v: Y4M stream, V: PPM sequence)
+            if (frameCaptureActive()) {
+                stopFrameCapture();
+            } else {
+                char name[64];
+                time_t now = time(NULL);
+                strftime(name, sizeof(name), "launch_%Y%m%d_%H%M%S", localtime(&now));
+                std::string path = name;
+                CaptureFormat format = CAPTURE_PPM_SEQUENCE;
+                if (key == 'v') {
+                    path += ".y4m";
+                    format = CAPTURE_Y4M;
+                }
+                startFrameCapture(format, path.c_str(), glutGet(GLUT_WINDOW_WIDTH),
+                                  glutGet(GLUT_WINDOW_HEIGHT), CAPTURE_FPS);
+            }
+            break;
+            
+        case 27: // ESC - exit
+            stopSimulationThread();
+            stopFrameCapture();
+            exit(0);
+            break;
+            
+        case 'r':
+        case 'R': // Reset: the prediction is render-side state
+            invalidateTrajectoryPrediction(trajectoryPrediction);
+            postInputEvent(INPUT_KEY_DOWN, key);
+            break;
+            
+        default:
+            postInputEvent(INPUT_KEY_DOWN, key);
+            break;
+    }
+    
+    // Force redraw
+    glutPostRedisplay();
+}
+
+void keyboardUp(unsigned char key, int x, int y) {
+    postInputEvent(INPUT_KEY_UP, key);
+}
+
+void specialKeys(int key, int x, int y) {
+    if (key == GLUT_KEY_F9) {
+        // Loading a checkpoint moves the rocket: drop the render-side prediction
+        invalidateTrajectoryPrediction(trajectoryPrediction);
+    }
+    postInputEvent(INPUT_SPECIAL_KEY, key);
+}
+
+// Simulation thread: apply a queued key press
+void handleKeyDown(unsigned char key) {
     keys[key] = true; // Mark key as pressed
     
     switch(key) {
         case ' ': // Space - start countdown
             if (currentState == PRELAUNCH) {
                 currentState = COUNTDOWN;
-                countdown = 10;
+                countdown = scenario.countdown;
                 std::cout << "Countdown started!" << std::endl;
             }
             break;
             
         case 'r':
-        case 'R': // Reset
-            rocketX = 400.0f;
-            rocketY = 150.0f;
-            rocketVelocity = 0.0f;
-            rocketAngle = 0.0f;
-            rocketLaunched = false;
-            rocketLaunching = false;
-            rocketExploded = false;
-            rocketFuel = 100.0f;
-            rocketStage = 1;
-            countdown = 10;
-            altitude = 0.0f;
-            velocity = 0.0f;
-            acceleration = 0.0f;
-            currentState = PRELAUNCH;
-            cameraFollowRocket = false;
-            cameraX = 400.0f;
-            cameraY = 300.0f;
-            cameraZoom = 1.0f;
-            cameraTargetX = 400.0f;
-            cameraTargetY = 300.0f;
-            cameraTargetZoom = 1.0f;
-            currentCameraMode = MODE_LAUNCH_PAD;
-            missionSuccess = false;
-            stage1Separated = false;
-            stage2Separated = false;
-            stage1Falling = false;
-            stage2Falling = false;
-            smokeParticles.clear();
-            explosionParticles.clear();
-            trajectoryPoints.clear();
-            showTrajectory = false;
-            initializeStages(); // Re-initialize stages
+        case 'R': // Reset to the state the run started from
+            resetSimulation();
             std::cout << "=== SIMULATION RESET ===" << std::endl;
             break;
             
@@ -327,6 +403,8 @@ void keyboard(unsigned char key, int x, int y) {
             std::cout << "Stage2 Separated: " << (stage2Separated ? "YES" : "NO") << std::endl;
             std::cout << "Camera Mode: " << currentCameraMode << std::endl;
             std::cout << "Flame Size: " << flameSize << std::endl;
+            std::cout << "Integrator: " << integratorName(currentIntegrator)
+                      << " (step " << simulationStep << ")" << std::endl;
             std::cout << "=== END STATUS ===" << std::endl;
             break;
 
@@ -347,8 +425,39 @@ void keyboard(unsigned char key, int x, int y) {
             std::cout << "Manual zoom out: " << cameraTargetZoom << "x" << std::endl;
             break;
             
-        case 27: // ESC - exit
-            exit(0);
+        case 'k':
+        case 'K': // Cycle integration method
+            if (currentIntegrator == INTEGRATOR_SEMI_IMPLICIT_EULER) {
+                currentIntegrator = INTEGRATOR_RK4;
+            } else if (currentIntegrator == INTEGRATOR_RK4) {
+                currentIntegrator = INTEGRATOR_RK45;
+            } else {
+                currentIntegrator = INTEGRATOR_SEMI_IMPLICIT_EULER;
+            }
+            std::cout << "Integrator: " << integratorName(currentIntegrator) << std::endl;
+            break;
+            
+        case '[': // Slower time warp
+            setTimeWarpLevel(timeWarpLevel - 1);
+            break;
+            
+        case ']': // Faster time warp
+            if (ticksUntilSeparation() < TIME_WARP_SEPARATION_MARGIN) {
+                std::cout << "Time warp unavailable: stage separation ahead" << std::endl;
+            } else {
+                setTimeWarpLevel(timeWarpLevel + 1);
+            }
+            break;
+            
+        case 'j':
+        case 'J': // Toggle serial update passes (debugging)
+            if (jobWorkerCount() > 0) {
+                startJobSystem(0);
+                std::cout << "Job system: serial" << std::endl;
+            } else {
+                startJobSystem(defaultJobWorkerCount());
+                std::cout << "Job system: " << jobWorkerCount() << " workers" << std::endl;
+            }
             break;
             
         default:
@@ -356,16 +465,27 @@ void keyboard(unsigned char key, int x, int y) {
             std::cout << "Key pressed: " << key << " (ASCII: " << (int)key << ")" << std::endl;
             break;
     }
-    
-    // Force redraw
-    glutPostRedisplay();
 }
 
-void keyboardUp(unsigned char key, int x, int y) {
+void handleKeyUp(unsigned char key) {
     keys[key] = false; // Mark key as released
 }
 
-void specialKeys(int key, int x, int y) {
+void handleSpecialKey(int key) {
+    switch(key) {
+        case GLUT_KEY_F5: // Quick save
+            if (saveSimulationCheckpoint(CHECKPOINT_FILE)) {
+                std::cout << "Checkpoint saved to " << CHECKPOINT_FILE << std::endl;
+            }
+            return;
+            
+        case GLUT_KEY_F9: // Quick load
+            if (loadSimulationCheckpoint(CHECKPOINT_FILE)) {
+                std::cout << "Checkpoint loaded from " << CHECKPOINT_FILE << std::endl;
+            }
+            return;
+    }
+    
     // Manual rocket control (for testing)
     if (rocketLaunching && rocketFuel > 0) {
         switch(key) {
@@ -378,12 +498,12 @@ void specialKeys(int key, int x, int y) {
                 std::cout << "Right arrow: Adjusting rocket angle to " << rocketAngle << " degrees" << std::endl;
                 break;
             case GLUT_KEY_UP:
-                rocketVelocity += 0.05f;
-                rocketFuel -= 1.0f;
+                rocketVelocity += MANUAL_THRUST_STEP;
+                rocketFuel -= MANUAL_THRUST_FUEL;
                 std::cout << "Up arrow: Increasing thrust, fuel: " << rocketFuel << "%" << std::endl;
                 break;
             case GLUT_KEY_DOWN:
-                rocketVelocity -= 0.05f;
+                rocketVelocity -= MANUAL_THRUST_STEP;
                 std::cout << "Down arrow: Decreasing thrust" << std::endl;
                 break;
         }
@@ -396,9 +516,37 @@ void specialKeys(int key, int x, int y) {
 
 // ========== MAIN FUNCTION ==========
 
+// Compile text scenarios into one pack: --pack out.rks a.txt b.txt ...
+static int packScenarios(int count, char** paths, const char* output) {
+    std::vector<ScenarioConfig> scenarios(count);
+    for (int i = 0; i < count; i++) {
+        if (!loadScenarioText(paths[i], scenarios[i])) return 1;
+    }
+    if (!writeScenarioPack(output, scenarios.data(), count)) return 1;
+    std::cout << "Packed " << count << " scenarios into " << output << std::endl;
+    return 0;
+}
+
 int main(int argc, char** argv) {
+    // Batch tooling runs without a window
+    if (argc >= 3 && std::string(argv[1]) == "--pack") {
+        return packScenarios(argc - 3, argv + 3, argv[2]);
+    }
+    
     // Initialize GLUT
     glutInit(&argc, argv);
+    
+    // Optional scenario (text file, pack or pack:index) or checkpoint
+    if (argc >= 2) {
+        std::string start = argv[1];
+        size_t extension = sizeof(CHECKPOINT_EXTENSION) - 1;
+        if (start.size() > extension &&
+            start.compare(start.size() - extension, extension, CHECKPOINT_EXTENSION) == 0) {
+            resumeFromCheckpoint(argv[1]);
+        } else if (!loadScenario(argv[1], scenario)) {
+            return 1;
+        }
+    }
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB);
     glutInitWindowSize(800, 600);
     glutInitWindowPosition(100, 100);
@@ -418,11 +566,10 @@ int main(int argc, char** argv) {
     // Initialize random seed
     srand(time(NULL));
     
-    // Initialize game objects
-    initializeStars();
-    initializeClouds();
-    initializeSatellites();
-    initializeMeteors();
+    // Initialize render-side caches (the simulation thread sets up the
+    // objects it owns when it starts)
+    initializeStars(scenario);
+    initializeTerrain(terrain);
     
     // Set callback functions
     glutDisplayFunc(display);
@@ -431,6 +578,7 @@ int main(int argc, char** argv) {
     glutKeyboardUpFunc(keyboardUp); // Register key up callback
     glutSpecialFunc(specialKeys);
     glutTimerFunc(0, timer, 0);
+    startSimulationThread();
     
     // Print controls
     // Update the print controls section in main()
@@ -454,9 +602,17 @@ int main(int argc, char** argv) {
     std::cout << "F: Add fuel (cheat)" << std::endl;
     std::cout << "P: Manual stage separation (for testing)" << std::endl;
     std::cout << "A: Auto-switch camera to falling stage" << std::endl;
+    std::cout << "K: Cycle integrator (Euler / RK4 / RK45)" << std::endl;
+    std::cout << "[ / ]: Time warp slower / faster (1x to 1000x)" << std::endl;
+    std::cout << "J: Toggle parallel/serial update passes" << std::endl;
+    std::cout << "V: Record frames (v: Y4M video, Shift+V: PPM sequence)" << std::endl;
+    std::cout << "F5 / F9: Save / load checkpoint (" << CHECKPOINT_FILE << ")" << std::endl;
     std::cout << "Arrow keys: Manual rocket control during launch" << std::endl;
     std::cout << "ESC: Exit" << std::endl;
     std::cout << "================================================" << std::endl;
+    std::cout << "Usage: rocket_simulator [scenario.txt | pack.rks[:index] | saved.rkcp]" << std::endl;
+    std::cout << "       rocket_simulator --pack out.rks scenario.txt ..." << std::endl;
+    std::cout << "================================================" << std::endl;
     std::cout << "FEATURES:" << std::endl;
     std::cout << "- Realistic stage separation with visual effects" << std::endl;
     std::cout << "- Multiple camera views (follow rocket or stages)" << std::endl;
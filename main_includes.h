@@ -18,6 +18,16 @@
 #include "constants_config.h"
 #include "globals_extern.h"
 #include "graphics_algorithms.h"
+#include "raster_batch.h"
+#include "level_of_detail.h"
+#include "text_renderer.h"
+#include "hud_widgets.h"
+#include "frame_capture.h"
+#include "simulation_thread.h"
+#include "simulation_snapshot.h"
+#include "job_system.h"
+#include "particle_rng.h"
+#include "particle_emitters.h"
 #include "functions_declarations.h"
 
 // GLUT callback declarations
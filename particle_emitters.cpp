@@ -0,0 +1,92 @@
+#include "particle_emitters.h"
+#include "particle_rng.h"
+
+// ========== DESCRIPTORS ==========
+// rate, offset x, offset y, size (+ inherited), speed, life (+ inherited),
+// alpha, color low, color high, shared color draw
+static const SmokeEmitter SMOKE_EMITTERS[SMOKE_EMITTER_COUNT] = {
+    // EMITTER_EXHAUST_STAGE1: dense white/gray smoke
+    {4.0f, {-10.0f, 10.0f}, {-35.0f, -20.0f}, {5.0f, 15.0f}, 0.0f, {0.1f, 0.6f},
+     {0.8f, 1.1f}, 0.0f, 0.9f, {0.7f, 0.7f, 0.7f}, {1.0f, 1.0f, 1.0f}, true},
+    // EMITTER_EXHAUST_STAGE2: cleaner, whiter smoke
+    {2.0f, {-4.5f, 4.5f}, {-25.0f, -15.0f}, {4.0f, 10.0f}, 0.0f, {0.15f, 0.55f},
+     {0.6f, 0.8f}, 0.0f, 0.8f, {0.95f, 0.95f, 0.95f}, {0.95f, 0.95f, 0.95f}, true},
+    // EMITTER_EXHAUST_PAYLOAD: very light, almost invisible
+    {0.2f, {-2.0f, 2.0f}, {-18.0f, -10.0f}, {2.0f, 6.0f}, 0.0f, {0.2f, 0.2f},
+     {0.4f, 0.5f}, 0.0f, 0.6f, {1.0f, 1.0f, 1.0f}, {1.0f, 1.0f, 1.0f}, true},
+    // EMITTER_TRAIL_STAGE1
+    {0.2f, {-10.0f, 10.0f}, {-10.0f, 10.0f}, {3.0f, 9.0f}, 0.0f, {0.2f, 0.2f},
+     {0.5f, 0.5f}, 0.0f, 0.6f, {0.6f, 0.6f, 0.6f}, {0.6f, 0.6f, 0.6f}, true},
+    // EMITTER_TRAIL_STAGE2
+    {0.125f, {-7.0f, 8.0f}, {-7.0f, 8.0f}, {2.0f, 6.0f}, 0.0f, {0.15f, 0.15f},
+     {0.4f, 0.4f}, 0.0f, 0.5f, {0.7f, 0.7f, 0.7f}, {0.7f, 0.7f, 0.7f}, true},
+    // EMITTER_SEPARATION_STAGE1: orange/brown
+    {30.0f, {-30.0f, 30.0f}, {-30.0f, 30.0f}, {2.0f, 8.0f}, 0.0f, {0.05f, 0.55f},
+     {0.6f, 1.0f}, 0.0f, 0.9f, {0.8f, 0.4f, 0.2f}, {1.0f, 0.7f, 0.4f}, false},
+    // EMITTER_SEPARATION_STAGE2: blue/gray
+    {30.0f, {-30.0f, 30.0f}, {-30.0f, 30.0f}, {2.0f, 8.0f}, 0.0f, {0.05f, 0.55f},
+     {0.6f, 1.0f}, 0.0f, 0.9f, {0.6f, 0.7f, 0.9f}, {0.8f, 0.9f, 1.0f}, false},
+    // EMITTER_EXPLOSION_SMOKE: dark, twice the particle's size
+    {1.0f, {0.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f}, 2.0f, {0.05f, 0.05f},
+     {0.0f, 0.0f}, 0.8f, 0.7f, {0.3f, 0.24f, 0.18f}, {0.5f, 0.4f, 0.3f}, true}
+};
+
+const SmokeEmitter& smokeEmitter(SmokeEmitterId emitter) {
+    return SMOKE_EMITTERS[emitter];
+}
+
+// ========== SPAWNING ==========
+static int spawnCount(const SmokeEmitter& emitter, SmokeEmitterId id, int source, unsigned long tick) {
+    int count = (int)emitter.rate;
+    float chance = emitter.rate - count;
+    if (chance > 0.0f) {
+        unsigned int draw = keyedRandom(EMITTER_RATE_RNG_KEY, ((unsigned int)id << 24) | (unsigned int)source, tick, 0);
+        if ((draw >> 8) * (1.0f / 16777216.0f) < chance) count++;
+    }
+    return count;
+}
+
+static float sampleRange(const FloatRange& range, unsigned int draw) {
+    return range.low + (range.high - range.low) * (draw * (1.0f / 65536.0f));
+}
+
+int emitSmoke(SmokeEmitterId id, const EmitterSource* sources, int count,
+              std::vector<SmokeParticle>& smoke, unsigned int& nextId, unsigned long tick) {
+    const SmokeEmitter& emitter = SMOKE_EMITTERS[id];
+    int total = 0;
+    for (int i = 0; i < count; i++) total += spawnCount(emitter, id, i, tick);
+    if (total == 0) return 0;
+
+    size_t first = smoke.size();
+    smoke.resize(first + total);
+    SmokeParticle* out = &smoke[first];
+    for (int i = 0; i < count; i++) {
+        const EmitterSource& source = sources[i];
+        for (int n = spawnCount(emitter, id, i, tick); n > 0; n--) {
+            SmokeParticle& particle = *out++;
+            particle.id = nextId++;
+
+            // Eight 16-bit draws from the particle's keyed words
+            unsigned int draws[2 * PARTICLE_RNG_DRAWS];
+            for (int d = 0; d < PARTICLE_RNG_DRAWS; d++) {
+                unsigned int word = keyedRandom(EMITTER_SPAWN_RNG_KEY, particle.id, tick, d);
+                draws[2 * d] = word & 0xFFFF;
+                draws[2 * d + 1] = word >> 16;
+            }
+
+            particle.x = source.x + sampleRange(emitter.offsetX, draws[0]);
+            particle.y = source.y + sampleRange(emitter.offsetY, draws[1]);
+            particle.size = sampleRange(emitter.size, draws[2]) + emitter.inheritSize * source.size;
+            particle.speed = sampleRange(emitter.speed, draws[3]);
+            particle.life = sampleRange(emitter.life, draws[4]) + emitter.inheritLife * source.life;
+            particle.alpha = emitter.alpha;
+
+            float* color[3] = {&particle.r, &particle.g, &particle.b};
+            for (int c = 0; c < 3; c++) {
+                FloatRange range = {emitter.colorLow[c], emitter.colorHigh[c]};
+                *color[c] = sampleRange(range, draws[emitter.sharedColorDraw ? 5 : 5 + c]);
+            }
+        }
+    }
+    return total;
+}
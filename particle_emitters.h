@@ -0,0 +1,69 @@
+// particle_emitters.h
+#ifndef PARTICLE_EMITTERS_H
+#define PARTICLE_EMITTERS_H
+
+#include <cstddef>
+#include <vector>
+#include "types_structures.h"
+
+// ================== SMOKE EMITTERS ==================
+// Every source of smoke is a descriptor in one table (particle_emitters.cpp):
+// how many particles it spawns per tick, the box they appear in around
+// their source, and the ranges their size, speed, life and color are drawn
+// from. emitSmoke spawns one tick of an emitter for a batch of sources,
+// sized once and written straight into the particle vector.
+//
+// All draws are keyed (particle_rng.h): the spawn chance on (emitter,
+// source index, tick), the particle's own draws on (particle id, tick). The
+// result does not depend on the thread that emits, so the explosion smoke
+// job and the simulation thread share the same code.
+struct FloatRange {
+    float low, high;  // Uniform in [low, high)
+};
+
+struct SmokeEmitter {
+    float rate;              // Particles per source and tick; the fraction is a chance
+    FloatRange offsetX;      // Spawn box around the source
+    FloatRange offsetY;
+    FloatRange size;
+    float inheritSize;       // Plus this much of the source's size
+    FloatRange speed;
+    FloatRange life;
+    float inheritLife;       // Plus this much of the source's life
+    float alpha;
+    float colorLow[3];       // RGB
+    float colorHigh[3];
+    bool sharedColorDraw;    // One draw across the channels (grays, tints)
+};
+
+// The emitters attached to stages and events; the exhaust of stage n is
+// EMITTER_EXHAUST_STAGE1 + n - 1
+enum SmokeEmitterId {
+    EMITTER_EXHAUST_STAGE1,
+    EMITTER_EXHAUST_STAGE2,
+    EMITTER_EXHAUST_PAYLOAD,
+    EMITTER_TRAIL_STAGE1,       // Falling spent stages
+    EMITTER_TRAIL_STAGE2,
+    EMITTER_SEPARATION_STAGE1,  // One-tick bursts
+    EMITTER_SEPARATION_STAGE2,
+    EMITTER_EXPLOSION_SMOKE,    // Behind young explosion particles
+    SMOKE_EMITTER_COUNT
+};
+
+const SmokeEmitter& smokeEmitter(SmokeEmitterId emitter);
+
+// Where an emitter fires; 'size' and 'life' are only read by emitters that
+// inherit them
+struct EmitterSource {
+    float x, y;
+    float size;
+    float life;
+};
+
+// Spawn one tick of 'emitter' at each of 'count' sources, appending to
+// 'smoke' and numbering the particles from 'nextId'. Returns the number
+// spawned.
+int emitSmoke(SmokeEmitterId emitter, const EmitterSource* sources, int count,
+              std::vector<SmokeParticle>& smoke, unsigned int& nextId, unsigned long tick);
+
+#endif
@@ -0,0 +1,55 @@
+// particle_rng.h
+#ifndef PARTICLE_RNG_H
+#define PARTICLE_RNG_H
+
+// ================== COUNTER-BASED PARTICLE RANDOMNESS ==================
+// "Squares" counter-based generator (Widynski 2020): four rounds of
+// squaring turn (counter, key) into 32 random bits with no state to share.
+// Particles key their draws on (particle id, simulation tick, draw index),
+// so a particle's jitter does not depend on which thread updates it or in
+// what order, and threaded updates match serial ones bit for bit.
+const unsigned long long PARTICLE_RNG_KEY = 0x548c9decbce65297ULL;
+const int PARTICLE_RNG_DRAWS = 4; // Independent draws per particle and tick
+
+inline unsigned int squares32(unsigned long long counter, unsigned long long key) {
+    unsigned long long x = counter * key;
+    unsigned long long y = x;
+    unsigned long long z = y + key;
+    x = x * x + y; x = (x >> 32) | (x << 32);
+    x = x * x + z; x = (x >> 32) | (x << 32);
+    x = x * x + y; x = (x >> 32) | (x << 32);
+    return (unsigned int)((x * x + z) >> 32);
+}
+
+// Draw 'draw' (0 .. PARTICLE_RNG_DRAWS-1) for object 'id' at 'tick' under 'key'
+inline unsigned int keyedRandom(unsigned long long key, unsigned int id, unsigned long tick, int draw) {
+    unsigned long long counter = ((unsigned long long)tick << 34) |
+                                 ((unsigned long long)id << 2) |
+                                 (unsigned long long)draw;
+    return squares32(counter, key);
+}
+
+inline unsigned int particleRandom(unsigned int id, unsigned long tick, int draw) {
+    return keyedRandom(PARTICLE_RNG_KEY, id, tick, draw);
+}
+
+// Scenery respawns (clouds, satellites, meteors) use their own key
+const unsigned long long SCENERY_RNG_KEY = 0xc8e4fd154ce32f6dULL;
+
+// Smoke emitters (particle_emitters.h): spawn chances, and the draws of a
+// new particle, which must not repeat its first tick of jitter
+const unsigned long long EMITTER_RATE_RNG_KEY = 0x3f6a2d9c85b1e47dULL;
+const unsigned long long EMITTER_SPAWN_RNG_KEY = 0xd2479be1c63a5f8bULL;
+
+// ================== SIMULATION RANDOM STREAM ==================
+// Sequential draws made on the simulation thread (spawning, separation
+// tilt, wind changes). The stream's whole state is its counter, which is
+// part of the simulation state, so a restored snapshot replays the same
+// draws.
+const unsigned long long SIMULATION_RNG_KEY = 0x9b1e5a3fd7c2864bULL;
+
+inline unsigned int nextRandom(unsigned long long& counter) {
+    return squares32(counter++, SIMULATION_RNG_KEY);
+}
+
+#endif
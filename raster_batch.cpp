@@ -0,0 +1,93 @@
+#include "raster_batch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+RasterBatch rasterBatch;
+
+void flushRasterBatch() {
+    if (rasterBatch.count == 0) return;
+
+    // Vertex colors leave the current color undefined: keep the caller's
+    GLfloat current[4];
+    glGetFloatv(GL_CURRENT_COLOR, current);
+
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_INT, sizeof(RasterVertex), &rasterBatch.vertices[0].x);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(RasterVertex), rasterBatch.vertices[0].color);
+    glDrawArrays(rasterBatch.mode, 0, rasterBatch.count);
+    glPopClientAttrib();
+    glColor4fv(current);
+    rasterBatch.count = 0;
+}
+
+void beginRasterBatch() {
+    rasterBatch.depth++;
+}
+
+void endRasterBatch() {
+    if (rasterBatch.depth > 0 && --rasterBatch.depth == 0) {
+        flushRasterBatch();
+    }
+}
+
+static GLubyte colorByte(GLfloat value) {
+    if (value <= 0.0f) return 0;
+    if (value >= 1.0f) return 255;
+    return (GLubyte)(value * 255.0f + 0.5f);
+}
+
+void currentRasterColor(GLubyte* color) {
+    GLfloat current[4];
+    glGetFloatv(GL_CURRENT_COLOR, current);
+    for (int i = 0; i < 4; i++) {
+        color[i] = colorByte(current[i]);
+    }
+}
+
+// Inverts the 2D affine part of projection * modelview and maps the
+// corners of clip space back through it
+RasterRect visibleRasterRect() {
+    const float unbounded = std::numeric_limits<float>::max();
+    RasterRect everything = {-unbounded, -unbounded, unbounded, unbounded};
+
+    GLfloat modelview[16], projection[16];
+    glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
+    glGetFloatv(GL_PROJECTION_MATRIX, projection);
+
+    // Column-major: m[column * 4 + row]
+    GLfloat m[16];
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 4; row++) {
+            GLfloat sum = 0.0f;
+            for (int k = 0; k < 4; k++) {
+                sum += projection[k * 4 + row] * modelview[column * 4 + k];
+            }
+            m[column * 4 + row] = sum;
+        }
+    }
+
+    if (m[3] != 0.0f || m[7] != 0.0f || m[15] != 1.0f) return everything;
+    float det = m[0] * m[5] - m[4] * m[1];
+    if (std::fabs(det) < 1e-12f) return everything;
+
+    float left = unbounded, bottom = unbounded;
+    float right = -unbounded, top = -unbounded;
+    for (int corner = 0; corner < 4; corner++) {
+        float u = ((corner & 1) ? 1.0f : -1.0f) - m[12];
+        float v = ((corner & 2) ? 1.0f : -1.0f) - m[13];
+        float x = (m[5] * u - m[4] * v) / det;
+        float y = (m[0] * v - m[1] * u) / det;
+        left = std::min(left, x);
+        right = std::max(right, x);
+        bottom = std::min(bottom, y);
+        top = std::max(top, y);
+    }
+
+    float margin = RASTER_CLIP_MARGIN * std::max(right - left, top - bottom);
+    RasterRect rect = {left - margin, bottom - margin, right + margin, top + margin};
+    return rect;
+}
@@ -0,0 +1,71 @@
+// raster_batch.h
+#ifndef RASTER_BATCH_H
+#define RASTER_BATCH_H
+
+#include "clipping.h"
+#include "constants_config.h"
+
+#ifdef __APPLE__
+#include <GLUT/glut.h>
+#else
+#include <GL/glut.h>
+#endif
+
+// ================== RASTER VERTEX BATCH ==================
+// The GL rasterizers append their pixels and segments here instead of
+// issuing a glVertex call per pixel. The batch holds one primitive type at
+// a time and is drawn with a single glDrawArrays whenever the type
+// changes, it fills up, or it is flushed, so draw order is unchanged.
+//
+// Each vertex carries the color that was current when its draw call
+// started, so callers may change glColor between draw calls. Between
+// beginRasterBatch() and endRasterBatch() consecutive draw calls share one
+// batch; the caller must not change the modelview matrix, point size or
+// line width or draw with glBegin inside that range. Outside such a range
+// every draw call flushes its own output. Render thread only.
+struct RasterVertex {
+    GLint x, y;
+    GLubyte color[4];
+};
+
+struct RasterBatch {
+    RasterVertex vertices[RASTER_BATCH_CAPACITY];
+    int count;
+    GLenum mode;  // GL_POINTS or GL_LINES while count > 0
+    int depth;    // Open beginRasterBatch() scopes
+};
+
+extern RasterBatch rasterBatch;
+
+void flushRasterBatch();
+void beginRasterBatch();
+void endRasterBatch(); // Flushes when the outermost scope closes
+
+// Room for 'needed' more vertices of 'mode', flushing the batch if not
+inline void reserveRasterBatch(GLenum mode, int needed) {
+    if (rasterBatch.count > 0 &&
+        (rasterBatch.mode != mode || rasterBatch.count + needed > RASTER_BATCH_CAPACITY)) {
+        flushRasterBatch();
+    }
+    rasterBatch.mode = mode;
+}
+
+inline void appendRasterVertex(int x, int y, const GLubyte* color) {
+    RasterVertex& vertex = rasterBatch.vertices[rasterBatch.count++];
+    vertex.x = x;
+    vertex.y = y;
+    vertex.color[0] = color[0];
+    vertex.color[1] = color[1];
+    vertex.color[2] = color[2];
+    vertex.color[3] = color[3];
+}
+
+// The current GL color as RGBA bytes
+void currentRasterColor(GLubyte* color);
+
+// The part of the current modelview coordinates that lands in the
+// viewport, with a margin for point size; unbounded under a projective
+// transform
+RasterRect visibleRasterRect();
+
+#endif
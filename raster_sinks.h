@@ -0,0 +1,386 @@
+// raster_sinks.h
+#ifndef RASTER_SINKS_H
+#define RASTER_SINKS_H
+
+#include "blend_spans.h"
+#include "constants_config.h"
+#include "framebuffer.h"
+#include "level_of_detail.h"
+#include "raster_batch.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// ================== RASTER SINKS ==================
+// Where the rasterizers in rasterizer.h send their output. A sink is any
+// type with these members; the rasterizers are templates on the sink, so
+// every call below is inlined into the algorithm's loop (no virtual
+// dispatch per pixel):
+//
+//   int rasterStep()                               LOD step: sink units per sample
+//   RasterRect visibleRect()                       clip rectangle (clipping.h)
+//   void pixel(int x, int y)                       one pixel
+//   void segment(int x0, int y0, int x1, int y1)   axis-aligned run, ends included
+
+// ========== GL ==========
+// Vertices in the shared raster batch (raster_batch.h), drawn with
+// glDrawArrays rather than one glVertex call per pixel. The sink samples
+// the current color once and the visible rectangle on first use; its
+// output is flushed when it goes out of scope unless a beginRasterBatch()
+// scope is open.
+struct GLRasterSink {
+    GLubyte color[4];
+    RasterRect clip;
+    bool clipKnown;  // Matrices are read on first use, once per sink
+
+    GLRasterSink() : clipKnown(false) { currentRasterColor(color); }
+    ~GLRasterSink() {
+        if (rasterBatch.depth == 0) flushRasterBatch();
+    }
+
+    int rasterStep() const { return lodRasterStep(); }
+    RasterRect visibleRect() {
+        if (!clipKnown) {
+            clip = visibleRasterRect();
+            clipKnown = true;
+        }
+        return clip;
+    }
+
+    void pixel(int x, int y) {
+        reserveRasterBatch(GL_POINTS, 1);
+        appendRasterVertex(x, y, color);
+    }
+
+    // GL lines leave out their last pixel: end one pixel past the run
+    void segment(int x0, int y0, int x1, int y1) {
+        if (x0 > x1 || y0 > y1) {
+            int t = x0; x0 = x1; x1 = t;
+            t = y0; y0 = y1; y1 = t;
+        }
+        if (y0 == y1) x1++;
+        else y1++;
+        reserveRasterBatch(GL_LINES, 2);
+        appendRasterVertex(x0, y0, color);
+        appendRasterVertex(x1, y1, color);
+    }
+};
+
+// ========== SOFTWARE ==========
+// Solid pixels in a Framebuffer, in framebuffer pixel coordinates;
+// anything outside the buffer is dropped. The anti-aliased rasterizers
+// (rasterizer_aa.h) also blend partly covered pixels toward the color
+// through
+//
+//   void coverage(int x, int y, float amount)                      amount in [0, 1]
+//   void coverageRow(int x, int y, const float* amounts, int count)
+//   void coveragePairs(bool steep, int major, const int* minors,
+//                      const unsigned short* fractions, int count)
+//
+// coveragePairs takes the inner columns of a Wu line: column major + i
+// gives pixel (major + i, minors[i]) 1 - f and the one above it f, with
+// f = fractions[i] / 65536 (x and y swapped when 'steep').
+inline unsigned int coverageWeight(float amount) {
+    return (unsigned int)(amount * 256.0f + 0.5f);
+}
+
+inline unsigned char coverageByte(float amount) {
+    return (unsigned char)(amount * 255.0f + 0.5f);
+}
+
+// Ask for a pixel's cache line ahead of a read-modify-write
+inline void prefetchPixel(const unsigned int* pixel) {
+#if defined(__GNUC__)
+    __builtin_prefetch(pixel, 1);
+#else
+    (void)pixel;
+#endif
+}
+
+// Pixel (x, y) of 'framebuffer', or 'discard' when it is outside
+inline unsigned int* pixelOrDiscard(Framebuffer& framebuffer, int x, int y, unsigned int* discard) {
+    bool inside = (unsigned)x < (unsigned)framebuffer.width && (unsigned)y < (unsigned)framebuffer.height;
+    return inside ? &framebuffer.pixels[(size_t)y * framebuffer.width + x] : discard;
+}
+
+// Column i of a coveragePairs() batch starting at 'first', when there is one
+inline void prefetchColumn(const unsigned int* first, const int* minors, int count, int i,
+                           ptrdiff_t majorStride, ptrdiff_t minorStride) {
+    if (i >= count) return;
+    const unsigned int* lower = first + i * majorStride + minors[i] * minorStride;
+    prefetchPixel(lower);
+    prefetchPixel(lower + minorStride);
+}
+
+// coveragePairs() weight of the upper pixel, out of 256
+inline unsigned int pairWeight(unsigned short fraction) {
+    return ((unsigned int)fraction + 128) >> 8;
+}
+
+#if defined(__SSE2__)
+// 16-bit lanes of 256 - w for the lower pixel's four channels, then w for
+// the upper pixel's
+inline __m128i pairWeights(unsigned short fraction) {
+    unsigned int weight = pairWeight(fraction);
+    __m128i v = _mm_cvtsi32_si128((int)((weight << 16) | (256 - weight)));
+    v = _mm_unpacklo_epi16(v, v);
+    return _mm_unpacklo_epi32(v, v);
+}
+
+// blendPixel on 16-bit channels: (source * w + destination * (256 - w)) >> 8
+inline __m128i blendLanes(__m128i destination, __m128i source, __m128i weights) {
+    __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(256), weights);
+    return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(source, weights), _mm_mullo_epi16(destination, inverse)), 8);
+}
+#endif
+
+struct FramebufferSink {
+    Framebuffer& target;
+    unsigned int color;
+
+    FramebufferSink(Framebuffer& framebuffer, unsigned int pixelColor)
+        : target(framebuffer), color(pixelColor) {}
+
+    int rasterStep() const { return 1; }
+
+    RasterRect visibleRect() const {
+        RasterRect rect = {0.0f, 0.0f, (float)target.width - 1.0f, (float)target.height - 1.0f};
+        return rect;
+    }
+
+    void pixel(int x, int y) {
+        if ((unsigned)x < (unsigned)target.width && (unsigned)y < (unsigned)target.height) {
+            target.pixels[(size_t)y * target.width + x] = color;
+        }
+    }
+
+    void segment(int x0, int y0, int x1, int y1) {
+        if (y0 == y1) {
+            if (x0 > x1) { int t = x0; x0 = x1; x1 = t; }
+            if ((unsigned)y0 >= (unsigned)target.height) return;
+            if (x0 < 0) x0 = 0;
+            if (x1 >= target.width) x1 = target.width - 1;
+            unsigned int* row = framebufferRow(target, y0);
+            for (int x = x0; x <= x1; x++) row[x] = color;
+        } else {
+            if (y0 > y1) { int t = y0; y0 = y1; y1 = t; }
+            if ((unsigned)x0 >= (unsigned)target.width) return;
+            if (y0 < 0) y0 = 0;
+            if (y1 >= target.height) y1 = target.height - 1;
+            for (int y = y0; y <= y1; y++) target.pixels[(size_t)y * target.width + x0] = color;
+        }
+    }
+
+    void coverage(int x, int y, float amount) {
+        if ((unsigned)x < (unsigned)target.width && (unsigned)y < (unsigned)target.height) {
+            unsigned int& pixel = target.pixels[(size_t)y * target.width + x];
+            pixel = blendPixel(pixel, color, coverageWeight(amount));
+        }
+    }
+
+    void coverageRow(int x, int y, const float* amounts, int count) {
+        if ((unsigned)y >= (unsigned)target.height) return;
+        int first = x < 0 ? -x : 0;
+        int last = std::min(count, target.width - x);
+        unsigned int* row = framebufferRow(target, y);
+        for (int i = first; i < last; i++) {
+            row[x + i] = blendPixel(row[x + i], color, coverageWeight(amounts[i]));
+        }
+    }
+
+    // Columns with both pixels inside the buffer skip the bounds checks
+    // and, with SSE2, are blended two (four pixels) per step; the columns
+    // RASTER_PREFETCH_DISTANCE ahead are requested first so their cache
+    // misses overlap. The minors are monotonic, so the inside columns are
+    // one run and only the ends of a batch can need checking.
+    void coveragePairs(bool steep, int major, const int* minors, const unsigned short* fractions, int count) {
+        int begin = 0;
+        int end = count;
+        while (begin < end && !pairInside(steep, major + begin, minors[begin])) begin++;
+        while (end > begin && !pairInside(steep, major + end - 1, minors[end - 1])) end--;
+        blendPairsChecked(steep, major, minors, fractions, 0, begin);
+        blendPairsChecked(steep, major, minors, fractions, end, count);
+        if (begin == end) return;
+        major += begin;
+        minors += begin;
+        fractions += begin;
+        count = end - begin;
+
+        const ptrdiff_t majorStride = steep ? target.width : 1;
+        const ptrdiff_t minorStride = steep ? 1 : target.width;
+        unsigned int* first = &target.pixels[0] + major * majorStride;
+        int i = 0;
+#if defined(__SSE2__)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i source = _mm_unpacklo_epi8(_mm_set1_epi32((int)color), zero);
+        for (; i + 1 < count; i += 2) {
+            prefetchColumn(first, minors, count, i + RASTER_PREFETCH_DISTANCE, majorStride, minorStride);
+            prefetchColumn(first, minors, count, i + 1 + RASTER_PREFETCH_DISTANCE, majorStride, minorStride);
+            unsigned int* a = first + i * majorStride + minors[i] * minorStride;
+            unsigned int* b = first + (i + 1) * majorStride + minors[i + 1] * minorStride;
+            __m128i pixels = _mm_set_epi32((int)b[minorStride], (int)b[0], (int)a[minorStride], (int)a[0]);
+            __m128i columnA = blendLanes(_mm_unpacklo_epi8(pixels, zero), source, pairWeights(fractions[i]));
+            __m128i columnB = blendLanes(_mm_unpackhi_epi8(pixels, zero), source, pairWeights(fractions[i + 1]));
+            pixels = _mm_packus_epi16(columnA, columnB);
+            a[0] = (unsigned int)_mm_cvtsi128_si32(pixels);
+            a[minorStride] = (unsigned int)_mm_cvtsi128_si32(_mm_srli_si128(pixels, 4));
+            b[0] = (unsigned int)_mm_cvtsi128_si32(_mm_srli_si128(pixels, 8));
+            b[minorStride] = (unsigned int)_mm_cvtsi128_si32(_mm_srli_si128(pixels, 12));
+        }
+#endif
+        for (; i < count; i++) {
+            prefetchColumn(first, minors, count, i + RASTER_PREFETCH_DISTANCE, majorStride, minorStride);
+            unsigned int* lower = first + i * majorStride + minors[i] * minorStride;
+            unsigned int weight = pairWeight(fractions[i]);
+            lower[0] = blendPixel(lower[0], color, 256 - weight);
+            lower[minorStride] = blendPixel(lower[minorStride], color, weight);
+        }
+    }
+
+    bool pairInside(bool steep, int major, int minor) const {
+        int majorSize = steep ? target.height : target.width;
+        int minorSize = steep ? target.width : target.height;
+        return (unsigned)major < (unsigned)majorSize && minor >= 0 && minor + 1 < minorSize;
+    }
+
+    void blendPairsChecked(bool steep, int major, const int* minors, const unsigned short* fractions,
+                           int from, int to) {
+        for (int i = from; i < to; i++) {
+            int x = steep ? minors[i] : major + i;
+            int y = steep ? major + i : minors[i];
+            unsigned int weight = pairWeight(fractions[i]);
+            unsigned int discard = 0;
+            unsigned int* lower = pixelOrDiscard(target, x, y, &discard);
+            *lower = blendPixel(*lower, color, 256 - weight);
+            unsigned int* upper = pixelOrDiscard(target, x + steep, y + !steep, &discard);
+            *upper = blendPixel(*upper, color, weight);
+        }
+    }
+};
+
+// Translucent output blended into a Framebuffer with the span kernels of
+// blend_spans.h (smoke, glows, HUD panels). 'color' is straight RGBA; every
+// pixel, segment and partly covered pixel is blended with it, the latter
+// scaled by their coverage.
+struct FramebufferBlendSink {
+    Framebuffer& target;
+    unsigned int premultiplied;
+    BlendMode mode;
+    bool gammaCorrect;
+
+    FramebufferBlendSink(Framebuffer& framebuffer, unsigned int color, BlendMode blendMode,
+                         bool linearLight = false)
+        : target(framebuffer), premultiplied(premultiplyColor(color)),
+          mode(blendMode), gammaCorrect(linearLight) {}
+
+    int rasterStep() const { return 1; }
+
+    RasterRect visibleRect() const {
+        RasterRect rect = {0.0f, 0.0f, (float)target.width - 1.0f, (float)target.height - 1.0f};
+        return rect;
+    }
+
+    void pixel(int x, int y) {
+        if ((unsigned)x < (unsigned)target.width && (unsigned)y < (unsigned)target.height) {
+            blendSpan(&target.pixels[(size_t)y * target.width + x], 1, premultiplied, mode, gammaCorrect);
+        }
+    }
+
+    void segment(int x0, int y0, int x1, int y1) {
+        if (y0 == y1) {
+            if (x0 > x1) { int t = x0; x0 = x1; x1 = t; }
+            if ((unsigned)y0 >= (unsigned)target.height) return;
+            if (x0 < 0) x0 = 0;
+            if (x1 >= target.width) x1 = target.width - 1;
+            if (x0 <= x1) blendSpan(framebufferRow(target, y0) + x0, x1 - x0 + 1, premultiplied, mode, gammaCorrect);
+        } else {
+            if (y0 > y1) { int t = y0; y0 = y1; y1 = t; }
+            for (int y = y0; y <= y1; y++) pixel(x0, y);
+        }
+    }
+
+    void coverage(int x, int y, float amount) {
+        if ((unsigned)x < (unsigned)target.width && (unsigned)y < (unsigned)target.height) {
+            unsigned char weight = coverageByte(amount);
+            blendSpanCoverage(&target.pixels[(size_t)y * target.width + x], &weight, 1,
+                              premultiplied, mode, gammaCorrect);
+        }
+    }
+
+    void coverageRow(int x, int y, const float* amounts, int count) {
+        if ((unsigned)y >= (unsigned)target.height) return;
+        int first = x < 0 ? -x : 0;
+        int last = std::min(count, target.width - x);
+        unsigned char weights[COVERAGE_CHUNK];
+        for (int start = first; start < last; start += COVERAGE_CHUNK) {
+            int n = std::min(COVERAGE_CHUNK, last - start);
+            for (int i = 0; i < n; i++) weights[i] = coverageByte(amounts[start + i]);
+            blendSpanCoverage(framebufferRow(target, y) + x + start, weights, n,
+                              premultiplied, mode, gammaCorrect);
+        }
+    }
+
+    void coveragePairs(bool steep, int major, const int* minors, const unsigned short* fractions, int count) {
+        for (int i = 0; i < count; i++) {
+            int x = steep ? minors[i] : major + i;
+            int y = steep ? major + i : minors[i];
+            unsigned char upper = (unsigned char)(((unsigned int)fractions[i] * 255 + 32768) >> 16);
+            unsigned char lower = (unsigned char)(255 - upper);
+            if (steep && (unsigned)y < (unsigned)target.height && x >= 0 && x + 1 < target.width) {
+                // Side by side in one row: one span of two
+                unsigned char weights[2] = {lower, upper};
+                blendSpanCoverage(framebufferRow(target, y) + x, weights, 2, premultiplied, mode, gammaCorrect);
+                continue;
+            }
+            unsigned int discard = 0;
+            blendSpanCoverage(pixelOrDiscard(target, x, y, &discard), &lower, 1, premultiplied, mode, gammaCorrect);
+            blendSpanCoverage(pixelOrDiscard(target, x + steep, y + !steep, &discard), &upper, 1,
+                              premultiplied, mode, gammaCorrect);
+        }
+    }
+};
+
+// ========== RECORDING ==========
+// Keeps the output for later inspection or replay: pixels as points,
+// segments as pairs of end points
+struct RasterPoint {
+    int x, y;
+};
+
+struct RecordingSink {
+    int step;
+    RasterRect clip;  // Unbounded unless set
+    std::vector<RasterPoint> pixels;
+    std::vector<RasterPoint> segments;
+
+    RecordingSink() : step(1) {
+        float unbounded = std::numeric_limits<float>::max();
+        RasterRect everything = {-unbounded, -unbounded, unbounded, unbounded};
+        clip = everything;
+    }
+
+    int rasterStep() const { return step; }
+    RasterRect visibleRect() const { return clip; }
+
+    void pixel(int x, int y) {
+        RasterPoint point = {x, y};
+        pixels.push_back(point);
+    }
+
+    void segment(int x0, int y0, int x1, int y1) {
+        RasterPoint start = {x0, y0};
+        RasterPoint end = {x1, y1};
+        segments.push_back(start);
+        segments.push_back(end);
+    }
+
+    void clear() {
+        pixels.clear();
+        segments.clear();
+    }
+};
+
+#endif
@@ -0,0 +1,384 @@
+// rasterizer.h
+#ifndef RASTERIZER_H
+#define RASTERIZER_H
+
+#include "clipping.h"
+#include "span_tables.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// ================== SINK-GENERIC RASTERIZERS ==================
+// The line, circle, ellipse and polygon algorithms, templated on the sink
+// that receives their pixels (see raster_sinks.h). Each instantiation is
+// compiled for one backend with the sink's pixel() inlined into the loop.
+// The draw*() functions in graphics_algorithms.h are these algorithms
+// instantiated for GLRasterSink.
+
+inline int rasterRound(float x) {
+    return static_cast<int>(x + 0.5f);
+}
+
+// ========== LINES ==========
+// Each line picks its octant once and runs a loop specialized for it. The
+// end points are ordered so the major axis always steps by +1; the
+// remaining octant is the major axis and the sign of the minor step.
+
+// DDA in 16.16 fixed point: the minor coordinate advances by a constant
+// fraction of a pixel per step and is rounded by its integer part
+template <bool XMajor, typename Sink>
+void rasterLineDDAOctant(Sink& sink, int major, int minor, int steps, int dMinor) {
+    long long scaled = (long long)dMinor << 16;
+    long long increment = (scaled + (scaled < 0 ? -steps : steps) / 2) / steps;
+    long long fraction = 0x8000;  // Half a pixel: truncation rounds
+    for (int i = 0; i <= steps; i++) {
+        int offset = (int)(fraction >> 16);
+        if (XMajor) sink.pixel(major + i, minor + offset);
+        else sink.pixel(minor + offset, major + i);
+        fraction += increment;
+    }
+}
+
+template <typename Sink>
+void rasterLineDDA(Sink& sink, int x1, int y1, int x2, int y2) {
+    int dx = x2 - x1;
+    int dy = y2 - y1;
+
+    if (dx == 0 && dy == 0) {
+        sink.pixel(x1, y1);
+        return;
+    }
+
+    if (std::abs(dx) >= std::abs(dy)) {
+        if (dx < 0) rasterLineDDAOctant<true>(sink, x2, y2, -dx, -dy);
+        else rasterLineDDAOctant<true>(sink, x1, y1, dx, dy);
+    } else {
+        if (dy < 0) rasterLineDDAOctant<false>(sink, y2, x2, -dy, -dx);
+        else rasterLineDDAOctant<false>(sink, y1, x1, dy, dx);
+    }
+}
+
+// Bresenham with the minor step written as selects rather than a branch,
+// so the loop compiles to conditional moves instead of mispredicted jumps
+template <bool XMajor, int StepMinor, typename Sink>
+void rasterLineBresenhamOctant(Sink& sink, int major, int minor, int dMajor, int dMinor) {
+    const int errorStep = 2 * dMinor;
+    const int errorCarry = -2 * dMajor;
+    int error = errorStep - dMajor;
+    for (int i = 0; i <= dMajor; i++) {
+        if (XMajor) sink.pixel(major + i, minor);
+        else sink.pixel(minor, major + i);
+        bool carry = error > 0;
+        minor += carry ? StepMinor : 0;
+        error += errorStep + (carry ? errorCarry : 0);
+    }
+}
+
+template <typename Sink>
+void rasterLineBresenham(Sink& sink, int x1, int y1, int x2, int y2) {
+    if (std::abs(x2 - x1) >= std::abs(y2 - y1)) {
+        if (x2 < x1) {
+            std::swap(x1, x2);
+            std::swap(y1, y2);
+        }
+        if (y2 >= y1) rasterLineBresenhamOctant<true, 1>(sink, x1, y1, x2 - x1, y2 - y1);
+        else rasterLineBresenhamOctant<true, -1>(sink, x1, y1, x2 - x1, y1 - y2);
+    } else {
+        if (y2 < y1) {
+            std::swap(x1, x2);
+            std::swap(y1, y2);
+        }
+        if (x2 >= x1) rasterLineBresenhamOctant<false, 1>(sink, y1, x1, y2 - y1, x2 - x1);
+        else rasterLineBresenhamOctant<false, -1>(sink, y1, x1, y2 - y1, x1 - x2);
+    }
+}
+
+// The float overloads clip against the sink's visible rectangle first, so
+// a line that is mostly off screen only steps through its visible part
+template <typename Sink>
+void rasterLineDDA(Sink& sink, float x1, float y1, float x2, float y2) {
+    if (!clipLine(x1, y1, x2, y2, sink.visibleRect())) return;
+    rasterLineDDA(sink, static_cast<int>(x1), static_cast<int>(y1),
+                  static_cast<int>(x2), static_cast<int>(y2));
+}
+
+template <typename Sink>
+void rasterLineBresenham(Sink& sink, float x1, float y1, float x2, float y2) {
+    if (!clipLine(x1, y1, x2, y2, sink.visibleRect())) return;
+    rasterLineBresenham(sink, static_cast<int>(x1), static_cast<int>(y1),
+                        static_cast<int>(x2), static_cast<int>(y2));
+}
+
+// ========== CIRCLES ==========
+// The 8 symmetric points of (x, y), scaled by the raster step
+template <typename Sink>
+inline void rasterCircleOctants(Sink& sink, int xc, int yc, int x, int y, int step) {
+    x *= step;
+    y *= step;
+    sink.pixel(xc + x, yc + y);
+    sink.pixel(xc - x, yc + y);
+    sink.pixel(xc + x, yc - y);
+    sink.pixel(xc - x, yc - y);
+    sink.pixel(xc + y, yc + x);
+    sink.pixel(xc - y, yc + x);
+    sink.pixel(xc + y, yc - x);
+    sink.pixel(xc - y, yc - x);
+}
+
+// Whether any of an ellipse's outline can be on screen: its bounds meet
+// the visible rectangle and the rectangle is not wholly inside it
+inline bool ellipseOutlineVisible(const RasterRect& rect, int xc, int yc, int rx, int ry, int step) {
+    return rectOverlaps(rect, (float)(xc - rx), (float)(yc - ry), (float)(xc + rx), (float)(yc + ry)) &&
+           !rectInsideEllipse(rect, (float)xc, (float)yc, (float)(rx - step), (float)(ry - step));
+}
+
+// Circles smaller than one raster step collapse to their center; larger
+// ones are walked one step (one screen pixel when zoomed out) at a time
+template <typename Sink>
+void rasterCircleMidpoint(Sink& sink, int xc, int yc, int radius) {
+    int step = sink.rasterStep();
+    if (radius <= 0 || radius < step) {
+        sink.pixel(xc, yc);
+        return;
+    }
+    if (!ellipseOutlineVisible(sink.visibleRect(), xc, yc, radius, radius, step)) return;
+
+    int x = 0;
+    int y = radius / step;
+    int d = 1 - y;  // Initial decision parameter
+    rasterCircleOctants(sink, xc, yc, x, y, step);
+
+    while (x < y) {
+        x++;
+        if (d < 0) {
+            d += 2 * x + 1;
+        } else {
+            y--;
+            d += 2 * (x - y) + 1;
+        }
+        rasterCircleOctants(sink, xc, yc, x, y, step);
+    }
+}
+
+// One horizontal segment per row, from the cached half-widths of rows
+// 0 .. 'rows' (span_tables.h) mirrored about the center row. Only the rows
+// and columns inside the visible rectangle are emitted.
+template <typename Sink>
+inline void rasterSpanRows(Sink& sink, int xc, int yc, const int* halfWidth, int rows, int step) {
+    RasterRect rect = sink.visibleRect();
+    int first = -rows;
+    int last = rows;
+    if (!clipRange(first, last, (rect.bottom - yc) / step, (rect.top - yc) / step)) return;
+
+    for (int row = first; row <= last; row++) {
+        int half = halfWidth[row < 0 ? -row : row] * step;
+        int y = yc + row * step;
+        int x0 = xc - half;
+        int x1 = xc + half;
+        if (clipRange(x0, x1, rect.left, rect.right)) sink.segment(x0, y, x1, y);
+    }
+}
+
+// Filled shapes wholly off screen are dropped before their table is built
+inline bool filledBoundsVisible(const RasterRect& rect, int xc, int yc, int rx, int ry) {
+    return rectOverlaps(rect, (float)(xc - rx), (float)(yc - ry), (float)(xc + rx), (float)(yc + ry));
+}
+
+template <typename Sink>
+void rasterFilledCircleMidpoint(Sink& sink, int xc, int yc, int radius) {
+    int step = sink.rasterStep();
+    if (radius <= 0 || radius < step) {
+        sink.pixel(xc, yc);
+        return;
+    }
+
+    if (!filledBoundsVisible(sink.visibleRect(), xc, yc, radius, radius)) return;
+
+    int rows = radius / step;
+    rasterSpanRows(sink, xc, yc, circleSpanTable(rows), rows, step);
+}
+
+// ========== ELLIPSES ==========
+template <typename Sink>
+inline void rasterEllipseQuadrants(Sink& sink, int xc, int yc, float x, float y, int step) {
+    int sx = static_cast<int>(x * step);
+    int sy = static_cast<int>(y * step);
+    sink.pixel(xc + sx, yc + sy);
+    sink.pixel(xc - sx, yc + sy);
+    sink.pixel(xc + sx, yc - sy);
+    sink.pixel(xc - sx, yc - sy);
+}
+
+template <typename Sink>
+void rasterEllipseMidpoint(Sink& sink, int xc, int yc, int rx, int ry) {
+    int step = sink.rasterStep();
+    if (rx < step && ry < step) {
+        sink.pixel(xc, yc);
+        return;
+    }
+    if (!ellipseOutlineVisible(sink.visibleRect(), xc, yc, rx, ry, step)) return;
+    rx /= step;
+    ry /= step;
+
+    float x = 0;
+    float y = ry;
+
+    // Region 1: slope above -1
+    float d1 = (ry * ry) - (rx * rx * ry) + (0.25f * rx * rx);
+    float dx = 2 * ry * ry * x;
+    float dy = 2 * rx * rx * y;
+    while (dx < dy) {
+        rasterEllipseQuadrants(sink, xc, yc, x, y, step);
+        x++;
+        dx = dx + (2 * ry * ry);
+        if (d1 < 0) {
+            d1 = d1 + dx + (ry * ry);
+        } else {
+            y--;
+            dy = dy - (2 * rx * rx);
+            d1 = d1 + dx - dy + (ry * ry);
+        }
+    }
+
+    // Region 2: slope below -1
+    float d2 = ((ry * ry) * ((x + 0.5f) * (x + 0.5f))) +
+               ((rx * rx) * ((y - 1) * (y - 1))) -
+               (rx * rx * ry * ry);
+    while (y >= 0) {
+        rasterEllipseQuadrants(sink, xc, yc, x, y, step);
+        y--;
+        dy = dy - (2 * rx * rx);
+        if (d2 > 0) {
+            d2 = d2 + (rx * rx) - dy;
+        } else {
+            x++;
+            dx = dx + (2 * ry * ry);
+            d2 = d2 + dx - dy + (rx * rx);
+        }
+    }
+}
+
+template <typename Sink>
+void rasterFilledEllipseMidpoint(Sink& sink, int xc, int yc, int rx, int ry) {
+    int step = sink.rasterStep();
+    if (rx < step && ry < step) {
+        sink.pixel(xc, yc);
+        return;
+    }
+    if (!filledBoundsVisible(sink.visibleRect(), xc, yc, rx, ry)) return;
+
+    rx /= step;
+    ry /= step;
+    rasterSpanRows(sink, xc, yc, ellipseSpanTable(rx, ry), ry, step);
+}
+
+// ========== POLYGONS ==========
+template <typename Sink>
+void rasterPolygonOutline(Sink& sink, const std::pair<float, float>* vertices, size_t count) {
+    if (count < 2) return;
+    for (size_t i = 0; i < count; i++) {
+        size_t next = (i + 1) % count;
+        rasterLineDDA(sink, vertices[i].first, vertices[i].second,
+                      vertices[next].first, vertices[next].second);
+    }
+}
+
+// Even-odd scanline fill, one DDA span per pair of edge crossings, of the
+// polygon clipped to the visible rectangle
+template <typename Sink>
+void rasterPolygonInterior(Sink& sink, const std::pair<float, float>* polygon, size_t polygonCount) {
+    if (polygonCount < 3) return;
+
+    // One unit of slack keeps the crossings of the edge rows intact
+    RasterRect rect = sink.visibleRect();
+    RasterRect bounds = {rect.left - 1.0f, rect.bottom - 1.0f, rect.right + 1.0f, rect.top + 1.0f};
+    size_t count;
+    const std::pair<float, float>* vertices = clipPolygon(polygon, polygonCount, bounds, count);
+    if (count < 3) return;
+
+    float minY = std::numeric_limits<float>::max();
+    float maxY = std::numeric_limits<float>::lowest();
+    for (size_t i = 0; i < count; i++) {
+        minY = std::min(minY, vertices[i].second);
+        maxY = std::max(maxY, vertices[i].second);
+    }
+
+    std::vector<float> intersections;
+    for (int scanY = static_cast<int>(minY); scanY <= static_cast<int>(maxY); scanY++) {
+        intersections.clear();
+        for (size_t i = 0; i < count; i++) {
+            size_t j = (i + 1) % count;
+            float xa = vertices[i].first, ya = vertices[i].second;
+            float xb = vertices[j].first, yb = vertices[j].second;
+            if ((ya <= scanY && yb > scanY) || (yb <= scanY && ya > scanY)) {
+                float t = (scanY - ya) / (yb - ya);
+                intersections.push_back(xa + t * (xb - xa));
+            }
+        }
+
+        std::sort(intersections.begin(), intersections.end());
+        for (size_t i = 0; i + 1 < intersections.size(); i += 2) {
+            rasterLineDDA(sink, intersections[i], static_cast<float>(scanY),
+                          intersections[i + 1], static_cast<float>(scanY));
+        }
+    }
+}
+
+// Scanline fill of a triangle split at its middle vertex, over the visible
+// scanlines only
+template <typename Sink>
+void rasterTriangleInterior(Sink& sink, float x1, float y1, float x2, float y2, float x3, float y3) {
+    float x[3] = {x1, x2, x3};
+    float y[3] = {y1, y2, y3};
+    for (int i = 0; i < 2; i++) {
+        for (int j = i + 1; j < 3; j++) {
+            if (y[i] > y[j]) {
+                std::swap(x[i], x[j]);
+                std::swap(y[i], y[j]);
+            }
+        }
+    }
+
+    RasterRect rect = sink.visibleRect();
+
+    // Upper part: vertex 0 to vertex 1
+    int first = static_cast<int>(y[0]);
+    int last = static_cast<int>(y[1]);
+    if (y[1] > y[0] && clipRange(first, last, rect.bottom, rect.top)) {
+        for (int scanY = first; scanY <= last; scanY++) {
+            float xleft = x[0] + (scanY - y[0]) / (y[2] - y[0]) * (x[2] - x[0]);
+            float xright = x[0] + (scanY - y[0]) / (y[1] - y[0]) * (x[1] - x[0]);
+            if (xleft > xright) std::swap(xleft, xright);
+            rasterLineDDA(sink, xleft, static_cast<float>(scanY), xright, static_cast<float>(scanY));
+        }
+    }
+
+    // Lower part: vertex 1 to vertex 2
+    first = static_cast<int>(y[1]);
+    last = static_cast<int>(y[2]);
+    if (y[2] > y[1] && clipRange(first, last, rect.bottom, rect.top)) {
+        for (int scanY = first; scanY <= last; scanY++) {
+            float xleft = x[0] + (scanY - y[0]) / (y[2] - y[0]) * (x[2] - x[0]);
+            float xright = x[1] + (scanY - y[1]) / (y[2] - y[1]) * (x[2] - x[1]);
+            if (xleft > xright) std::swap(xleft, xright);
+            rasterLineDDA(sink, xleft, static_cast<float>(scanY), xright, static_cast<float>(scanY));
+        }
+    }
+}
+
+template <typename Sink>
+void rasterFilledTriangle(Sink& sink, float x1, float y1, float x2, float y2, float x3, float y3) {
+    rasterTriangleInterior(sink, x1, y1, x2, y2, x3, y3);
+    std::pair<float, float> outline[3] = {{x1, y1}, {x2, y2}, {x3, y3}};
+    rasterPolygonOutline(sink, outline, 3);
+}
+
+template <typename Sink>
+void rasterFilledPolygon(Sink& sink, const std::pair<float, float>* vertices, size_t count) {
+    rasterPolygonInterior(sink, vertices, count);
+    rasterPolygonOutline(sink, vertices, count);
+}
+
+#endif
@@ -0,0 +1,124 @@
+#include "rasterizer_aa.h"
+#include <vector>
+
+// ========== POLYGON COVERAGE ==========
+// Each edge adds, to the cells it crosses, the area it sweeps to its
+// right within the row, signed by its direction, and widens the row's
+// touched range.
+struct CoverageCells {
+    std::vector<float> cells;
+    std::vector<int> rowFirst;
+    std::vector<int> rowLast;
+};
+
+static thread_local CoverageCells coverageCells;
+
+// Edge a-b in grid coordinates, where cell i spans [i, i + 1)
+static void accumulateEdge(CoverageCells& grid, int width, int height, float ax, float ay, float bx, float by) {
+    const int stride = width + 2;
+    if (ay == by) return;
+
+    float direction = 1.0f;
+    if (ay > by) {
+        std::swap(ax, bx);
+        std::swap(ay, by);
+        direction = -1.0f;
+    }
+
+    float dxdy = (bx - ax) / (by - ay);
+    float x = ax;
+    int firstRow = (int)ay;
+    if (ay < 0.0f) {
+        x -= ay * dxdy;
+        firstRow = 0;
+    }
+    int lastRow = std::min(height, (int)std::ceil(by));
+
+    for (int row = firstRow; row < lastRow; row++) {
+        float* line = &grid.cells[(size_t)row * stride];
+        float dy = std::min((float)(row + 1), by) - std::max((float)row, ay);
+        float xNext = x + dxdy * dy;
+        float d = dy * direction;
+        // Clamped so rounding at the clip edges cannot step outside
+        float x0 = std::max(std::min(x, xNext), 0.0f);
+        float x1 = std::min(std::max(x, xNext), (float)width);
+        float x0Floor = std::floor(x0);
+        float x1Ceil = std::ceil(x1);
+        int x0Cell = (int)x0Floor;
+        int x1Cell = (int)x1Ceil;
+        grid.rowFirst[row] = std::min(grid.rowFirst[row], x0Cell);
+        grid.rowLast[row] = std::max(grid.rowLast[row], x1Cell);
+
+        if (x1Cell <= x0Cell + 1) {
+            // Within one cell: split by the mean x
+            float xMean = 0.5f * (x0 + x1) - x0Floor;
+            line[x0Cell] += d - d * xMean;
+            line[x0Cell + 1] += d * xMean;
+        } else {
+            // Across cells: a triangle in the first and last, a trapezoid
+            // of constant width in each between
+            float s = 1.0f / (x1 - x0);
+            float x0Fraction = x0 - x0Floor;
+            float firstArea = 0.5f * s * (1.0f - x0Fraction) * (1.0f - x0Fraction);
+            float x1Fraction = x1 - x1Ceil + 1.0f;
+            float lastArea = 0.5f * s * x1Fraction * x1Fraction;
+            line[x0Cell] += d * firstArea;
+            if (x1Cell == x0Cell + 2) {
+                line[x0Cell + 1] += d * (1.0f - firstArea - lastArea);
+            } else {
+                float secondArea = s * (1.5f - x0Fraction);
+                line[x0Cell + 1] += d * (secondArea - firstArea);
+                for (int cell = x0Cell + 2; cell < x1Cell - 1; cell++) {
+                    line[cell] += d * s;
+                }
+                float throughArea = secondArea + (float)(x1Cell - x0Cell - 3) * s;
+                line[x1Cell - 1] += d * (1.0f - throughArea - lastArea);
+            }
+            line[x1Cell] += d * lastArea;
+        }
+        x = xNext;
+    }
+}
+
+bool polygonCoverage(const std::pair<float, float>* vertices, size_t count,
+                     const RasterRect& rect, CoverageGrid& grid) {
+    // Pixel x spans [x - 0.5, x + 0.5]: clip to the visible pixels' squares
+    RasterRect bounds = {rect.left - 0.5f, rect.bottom - 0.5f, rect.right + 0.5f, rect.top + 0.5f};
+    size_t clippedCount;
+    const std::pair<float, float>* clipped = clipPolygon(vertices, count, bounds, clippedCount);
+    if (clippedCount < 3) return false;
+
+    float left = clipped[0].first, right = left;
+    float bottom = clipped[0].second, top = bottom;
+    for (size_t i = 1; i < clippedCount; i++) {
+        left = std::min(left, clipped[i].first);
+        right = std::max(right, clipped[i].first);
+        bottom = std::min(bottom, clipped[i].second);
+        top = std::max(top, clipped[i].second);
+    }
+
+    grid.originX = (int)std::floor(left + 0.5f);
+    grid.originY = (int)std::floor(bottom + 0.5f);
+    grid.width = (int)std::floor(right + 0.5f) - grid.originX + 1;
+    grid.height = (int)std::floor(top + 0.5f) - grid.originY + 1;
+    grid.stride = grid.width + 2;  // Edges touch one cell past the right end
+
+    CoverageCells& cells = coverageCells;
+    cells.cells.assign((size_t)grid.stride * grid.height, 0.0f);
+    cells.rowFirst.assign(grid.height, grid.width);
+    cells.rowLast.assign(grid.height, -1);
+
+    float offsetX = 0.5f - grid.originX;
+    float offsetY = 0.5f - grid.originY;
+    for (size_t i = 0; i < clippedCount; i++) {
+        const std::pair<float, float>& a = clipped[i];
+        const std::pair<float, float>& b = clipped[(i + 1) % clippedCount];
+        accumulateEdge(cells, grid.width, grid.height,
+                       a.first + offsetX, a.second + offsetY, b.first + offsetX, b.second + offsetY);
+    }
+
+    grid.cells = &cells.cells[0];
+    grid.rowFirst = &cells.rowFirst[0];
+    grid.rowLast = &cells.rowLast[0];
+    return true;
+}
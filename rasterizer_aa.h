@@ -0,0 +1,330 @@
+// rasterizer_aa.h
+#ifndef RASTERIZER_AA_H
+#define RASTERIZER_AA_H
+
+#include "clipping.h"
+#include "constants_config.h"
+#include "simd_lanes.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+// ================== ANTI-ALIASED RASTERIZERS ==================
+// Coverage-based counterparts of the rasterizers in rasterizer.h for the
+// software backend. Every pixel gets the fraction of it the primitive
+// covers: fully covered runs go to the sink as segments, partly covered
+// pixels through coverage() / coverageRow() (see FramebufferSink). Pixel
+// (x, y) is the unit square centered on (x, y), as in the aliased
+// algorithms. Area coverage of curves and polygons is computed four pixels
+// at a time (simd_lanes.h).
+
+inline int floorToInt(float v) {
+    int i = (int)v;
+    return i - (v < (float)i);
+}
+
+inline int ceilToInt(float v) {
+    int i = (int)v;
+    return i + (v > (float)i);
+}
+
+// Solid runs become segments, partial runs one coverageRow() each, and
+// empty pixels are skipped
+template <typename Sink>
+void rasterCoverageRow(Sink& sink, int x, int y, const float* amounts, int count) {
+    int i = 0;
+    while (i < count) {
+        int start = i;
+        if (amounts[i] >= COVERAGE_SOLID) {
+            while (i < count && amounts[i] >= COVERAGE_SOLID) i++;
+            sink.segment(x + start, y, x + i - 1, y);
+        } else if (amounts[i] <= COVERAGE_EMPTY) {
+            while (i < count && amounts[i] <= COVERAGE_EMPTY) i++;
+        } else {
+            while (i < count && amounts[i] > COVERAGE_EMPTY && amounts[i] < COVERAGE_SOLID) i++;
+            sink.coverageRow(x + start, y, amounts + start, i - start);
+        }
+    }
+}
+
+// ========== LINES ==========
+// Xiaolin Wu: each column along the major axis splits its coverage between
+// the two pixels nearest the line, and the end columns are weighted by how
+// much of them the line spans
+template <bool Steep, typename Sink>
+inline void rasterWuColumn(Sink& sink, int major, float y, float weight) {
+    int minor = floorToInt(y);
+    float upper = (y - minor) * weight;
+    if (Steep) {
+        sink.coverage(minor, major, weight - upper);
+        sink.coverage(minor + 1, major, upper);
+    } else {
+        sink.coverage(major, minor, weight - upper);
+        sink.coverage(major, minor + 1, upper);
+    }
+}
+
+// The inner columns step the minor axis in 16.16 fixed point, like the
+// DDA kernel in rasterizer.h, and go to the sink COVERAGE_CHUNK at a time
+// as (minor, fraction) pairs rather than two coverage() calls each, so the
+// sink can blend several columns per step and read ahead of them
+template <bool Steep, typename Sink>
+void rasterLineWuColumns(Sink& sink, float x1, float y1, float x2, float y2) {
+    float dx = x2 - x1;
+    float gradient = dx > 0.0f ? (y2 - y1) / dx : 0.0f;
+    int first = floorToInt(x1 + 0.5f);
+    int last = floorToInt(x2 + 0.5f);
+    if (first == last) {
+        rasterWuColumn<Steep>(sink, first, y1 + gradient * (first - x1), dx);
+        return;
+    }
+
+    rasterWuColumn<Steep>(sink, first, y1 + gradient * (first - x1), 1.0f - (x1 + 0.5f - first));
+    rasterWuColumn<Steep>(sink, last, y1 + gradient * (last - x1), x2 + 0.5f - last);
+
+    long long y = (long long)std::floor((y1 + gradient * (first + 1 - x1)) * 65536.0f);
+    const long long step = (long long)std::floor(gradient * 65536.0f + 0.5f);
+    int minors[COVERAGE_CHUNK];
+    unsigned short fractions[COVERAGE_CHUNK];
+    for (int start = first + 1; start < last; start += COVERAGE_CHUNK) {
+        int count = std::min(COVERAGE_CHUNK, last - start);
+        for (int i = 0; i < count; i++) {
+            minors[i] = (int)(y >> 16);
+            fractions[i] = (unsigned short)(y & 0xFFFF);
+            y += step;
+        }
+        sink.coveragePairs(Steep, start, minors, fractions, count);
+    }
+}
+
+template <typename Sink>
+void rasterLineWu(Sink& sink, float x1, float y1, float x2, float y2) {
+    RasterRect rect = sink.visibleRect();
+    RasterRect bounds = {rect.left - 1.0f, rect.bottom - 1.0f, rect.right + 1.0f, rect.top + 1.0f};
+    if (!clipLine(x1, y1, x2, y2, bounds)) return;
+
+    if (std::fabs(y2 - y1) > std::fabs(x2 - x1)) {
+        if (y1 > y2) rasterLineWuColumns<true>(sink, y2, x2, y1, x1);
+        else rasterLineWuColumns<true>(sink, y1, x1, y2, x2);
+    } else {
+        if (x1 > x2) rasterLineWuColumns<false>(sink, x2, y2, x1, y1);
+        else rasterLineWuColumns<false>(sink, x1, y1, x2, y2);
+    }
+}
+
+// ========== CIRCLES AND ELLIPSES ==========
+// Per-shape constants of the coverage of an ellipse centered on (xc, yc)
+struct EllipseCoverage {
+    float xc, yc;
+    float rx, ry;
+    float invRx2, invRx4;
+    float invRy2, invRy4;
+    float outerRx, outerInvRy2;  // Semi-axes 'band' outside the edge
+    float innerRx, innerInvRy2;  // and inside it (0 when too small)
+};
+
+// Past 'band' pixels from the edge the coverage is constant
+inline EllipseCoverage makeEllipseCoverage(float xc, float yc, float rx, float ry, float band) {
+    EllipseCoverage e;
+    e.xc = xc;
+    e.yc = yc;
+    e.rx = rx;
+    e.ry = ry;
+    e.invRx2 = 1.0f / (rx * rx);
+    e.invRx4 = e.invRx2 * e.invRx2;
+    e.invRy2 = 1.0f / (ry * ry);
+    e.invRy4 = e.invRy2 * e.invRy2;
+    e.outerRx = rx + band;
+    e.outerInvRy2 = 1.0f / ((ry + band) * (ry + band));
+    bool hasInner = rx > band && ry > band;
+    e.innerRx = hasInner ? rx - band : 0.0f;
+    e.innerInvRy2 = hasInner ? 1.0f / ((ry - band) * (ry - band)) : 0.0f;
+    return e;
+}
+
+// Half-width at height v of the ellipse with semi-axes a and
+// 1 / sqrt(invB2), or -1 when the row misses it
+inline float ellipseHalfWidth(float a, float invB2, float v) {
+    float t = 1.0f - v * v * invB2;
+    return (a <= 0.0f || t < 0.0f) ? -1.0f : a * std::sqrt(t);
+}
+
+// Coverage of columns x0..x1 of the row at height v from the center. The
+// distance to the edge is the implicit function over its gradient, which
+// is exact for circles to first order: filled shapes cover 0.5 - d, and
+// outlines are a one pixel stroke covering 1 - |d|. The reciprocal square
+// root estimate errs well below one 1/256 coverage step.
+template <bool Filled, typename Sink>
+void rasterEllipseBand(Sink& sink, const EllipseCoverage& e, int x0, int x1, int y, float v,
+                       const RasterRect& rect) {
+    if (x0 > x1 || !clipRange(x0, x1, rect.left, rect.right)) return;
+
+    const Lanes invRx2 = splat(e.invRx2);
+    const Lanes invRx4 = splat(e.invRx4);
+    const Lanes rowTerm = splat(v * v * e.invRy2 - 1.0f);
+    const Lanes rowGradient = splat(v * v * e.invRy4);
+    const Lanes half = splat(0.5f);
+    const Lanes tiny = splat(1e-12f);
+
+    float amounts[COVERAGE_CHUNK];
+    for (int start = x0; start <= x1; start += COVERAGE_CHUNK) {
+        int count = std::min(COVERAGE_CHUNK, x1 - start + 1);
+        Lanes u = add(splat(start - e.xc), laneIndices());
+        for (int i = 0; i < count; i += 4) {
+            Lanes u2 = mul(u, u);
+            Lanes f = add(mul(u2, invRx2), rowTerm);
+            Lanes inverseGradient = rsqrtLanes(maxLanes(add(mul(u2, invRx4), rowGradient), tiny));
+            Lanes d = mul(mul(f, inverseGradient), half);
+            Lanes c = Filled ? sub(half, d) : sub(splat(1.0f), absLanes(d));
+            storeLanes(amounts + i, clampLanes(c, 0.0f, 1.0f));
+            u = add(u, splat(4.0f));
+        }
+        rasterCoverageRow(sink, start, y, amounts, count);
+    }
+}
+
+// Each row has an edge band between the ellipses just outside and just
+// inside the edge, where coverage is computed: half a pixel each way for
+// filled shapes, one pixel for outlines. Between the inner bands the row
+// is solid for filled shapes and empty for outlines.
+template <bool Filled, typename Sink>
+void rasterEllipseCoverage(Sink& sink, float xc, float yc, float rx, float ry) {
+    if (rx <= 0.0f || ry <= 0.0f) return;
+
+    const float band = Filled ? 0.5f : 1.0f;
+    RasterRect rect = sink.visibleRect();
+    if (!rectOverlaps(rect, xc - rx - band, yc - ry - band, xc + rx + band, yc + ry + band)) return;
+    if (!Filled && rectInsideEllipse(rect, xc, yc, rx - band, ry - band)) return;
+
+    int first = ceilToInt(yc - ry - band);
+    int last = floorToInt(yc + ry + band);
+    if (!clipRange(first, last, rect.bottom, rect.top)) return;
+
+    EllipseCoverage e = makeEllipseCoverage(xc, yc, rx, ry, band);
+    for (int y = first; y <= last; y++) {
+        float v = y - yc;
+        float outer = ellipseHalfWidth(e.outerRx, e.outerInvRy2, v);
+        if (outer < 0.0f) continue;
+        int left = ceilToInt(xc - outer);
+        int right = floorToInt(xc + outer);
+
+        float inner = ellipseHalfWidth(e.innerRx, e.innerInvRy2, v);
+        if (inner < 0.0f) {
+            rasterEllipseBand<Filled>(sink, e, left, right, y, v, rect);
+            continue;
+        }
+
+        int solidLeft = ceilToInt(xc - inner);
+        int solidRight = floorToInt(xc + inner);
+        rasterEllipseBand<Filled>(sink, e, left, solidLeft - 1, y, v, rect);
+        if (Filled && clipRange(solidLeft, solidRight, rect.left, rect.right)) {
+            sink.segment(solidLeft, y, solidRight, y);
+        }
+        rasterEllipseBand<Filled>(sink, e, solidRight + 1, right, y, v, rect);
+    }
+}
+
+template <typename Sink>
+void rasterCircleAA(Sink& sink, float xc, float yc, float radius) {
+    rasterEllipseCoverage<false>(sink, xc, yc, radius, radius);
+}
+
+template <typename Sink>
+void rasterFilledCircleAA(Sink& sink, float xc, float yc, float radius) {
+    rasterEllipseCoverage<true>(sink, xc, yc, radius, radius);
+}
+
+template <typename Sink>
+void rasterEllipseAA(Sink& sink, float xc, float yc, float rx, float ry) {
+    rasterEllipseCoverage<false>(sink, xc, yc, rx, ry);
+}
+
+template <typename Sink>
+void rasterFilledEllipseAA(Sink& sink, float xc, float yc, float rx, float ry) {
+    rasterEllipseCoverage<true>(sink, xc, yc, rx, ry);
+}
+
+// ========== POLYGONS ==========
+// Signed area accumulation of a polygon clipped to 'rect': each edge adds
+// to the cells it crosses, and the running sum along a row is the covered
+// area of each pixel (nonzero winding, overlaps saturating at 1). Row r
+// covers pixels (originX + i, originY + r) with deltas at
+// cells[r * stride + i]; cells outside [rowFirst[r], rowLast[r]] are
+// untouched and empty. Returns false when nothing is visible. The grid is
+// per thread and valid until the next call on that thread.
+struct CoverageGrid {
+    int originX, originY;
+    int width, height;
+    int stride;
+    const float* cells;
+    const int* rowFirst;
+    const int* rowLast;
+};
+
+bool polygonCoverage(const std::pair<float, float>* vertices, size_t count,
+                     const RasterRect& rect, CoverageGrid& grid);
+
+// Between edges the deltas are zero and the coverage constant, so a row
+// is walked in runs: each one becomes a segment, a skip, or a stretch of
+// a partial coverage row
+template <typename Sink>
+void rasterCoverageDeltas(Sink& sink, int x, int y, const float* deltas, int first, int last) {
+    float amounts[COVERAGE_CHUNK];
+    int pendingStart = 0;
+    int pendingCount = 0;
+    float area = 0.0f;
+    const Lanes zero = splat(0.0f);
+
+    for (int i = first; i <= last;) {
+        area += deltas[i];
+        float amount = std::min(std::fabs(area), 1.0f);
+        int end = i + 1;
+        while (end + 4 <= last + 1 && laneBits(equal(loadLanes(deltas + end), zero)) == 15) end += 4;
+        while (end <= last && deltas[end] == 0.0f) end++;
+
+        bool partial = amount > COVERAGE_EMPTY && amount < COVERAGE_SOLID;
+        if (pendingCount > 0 && (!partial || pendingCount + (end - i) > COVERAGE_CHUNK)) {
+            sink.coverageRow(x + pendingStart, y, amounts, pendingCount);
+            pendingCount = 0;
+        }
+        if (partial) {
+            if (end - i > COVERAGE_CHUNK) {
+                // A long partial run (a nearly horizontal edge): its own rows
+                for (int start = i; start < end; start += COVERAGE_CHUNK) {
+                    int count = std::min(COVERAGE_CHUNK, end - start);
+                    for (int k = 0; k < count; k++) amounts[k] = amount;
+                    sink.coverageRow(x + start, y, amounts, count);
+                }
+            } else {
+                if (pendingCount == 0) pendingStart = i;
+                for (int k = i; k < end; k++) amounts[pendingCount++] = amount;
+            }
+        } else if (amount >= COVERAGE_SOLID) {
+            sink.segment(x + i, y, x + end - 1, y);
+        }
+        i = end;
+    }
+    if (pendingCount > 0) sink.coverageRow(x + pendingStart, y, amounts, pendingCount);
+}
+
+template <typename Sink>
+void rasterFilledPolygonAA(Sink& sink, const std::pair<float, float>* vertices, size_t count) {
+    if (count < 3) return;
+
+    CoverageGrid grid;
+    if (!polygonCoverage(vertices, count, sink.visibleRect(), grid)) return;
+    for (int row = 0; row < grid.height; row++) {
+        if (grid.rowFirst[row] > grid.rowLast[row]) continue;
+        rasterCoverageDeltas(sink, grid.originX, grid.originY + row, grid.cells + (size_t)row * grid.stride,
+                             grid.rowFirst[row], std::min(grid.rowLast[row], grid.width - 1));
+    }
+}
+
+template <typename Sink>
+void rasterFilledTriangleAA(Sink& sink, float x1, float y1, float x2, float y2, float x3, float y3) {
+    std::pair<float, float> corners[3] = {{x1, y1}, {x2, y2}, {x3, y3}};
+    rasterFilledPolygonAA(sink, corners, 3);
+}
+
+#endif
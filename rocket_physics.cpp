@@ -0,0 +1,143 @@
+#include "rocket_physics.h"
+
+bool applyStageSeparation(RocketFlightState& state, int stageNum) {
+    bool& separated = (stageNum == 1) ? state.stage1Separated : state.stage2Separated;
+    if ((stageNum != 1 && stageNum != 2) || separated) return false;
+
+    // The next stage takes over with its own fuel, losing a little velocity
+    const StageSeparationRule& rule = STAGE_SEPARATION_RULES[stageNum - 1];
+    separated = true;
+    state.stage = stageNum + 1;
+    state.fuel = rule.nextFuel;
+    state.velocity *= rule.velocityRetention;
+    return true;
+}
+
+// Automatic separation rules while the engine is burning
+static int poweredSeparation(const RocketFlightState& state, const char*& reason) {
+    float altitude = state.y - 150.0f;
+    bool pending = (state.stage == 1 && !state.stage1Separated) ||
+                   (state.stage == 2 && !state.stage2Separated);
+    if (!pending) return 0;
+
+    const StageSeparationRule& rule = STAGE_SEPARATION_RULES[state.stage - 1];
+    if (altitude > rule.normalAltitude && state.fuel < rule.normalFuel && state.velocity > rule.normalVelocity) {
+        reason = "Normal separation (altitude, fuel and velocity)";
+        return state.stage;
+    }
+    if (state.fuel < rule.emergencyFuel) {
+        reason = "Emergency separation (low fuel)";
+        return state.stage;
+    }
+    if (altitude > rule.maxAltitude) {
+        reason = "Altitude separation (stage ceiling)";
+        return state.stage;
+    }
+    return 0;
+}
+
+// Separation rules once the tank is empty
+static int coastingSeparation(const RocketFlightState& state, const char*& reason) {
+    float altitude = state.y - 150.0f;
+
+    if (state.stage == 1 && !state.stage1Separated && altitude > STAGE_SEPARATION_RULES[0].coastAltitude) {
+        reason = "Out of fuel";
+        return 1;
+    }
+    if (state.stage == 2 && !state.stage2Separated && altitude > STAGE_SEPARATION_RULES[1].coastAltitude) {
+        reason = "Out of fuel";
+        return 2;
+    }
+    return 0;
+}
+
+static void separate(RocketFlightState& state, int stageNum, FlightStepResult& result) {
+    if (stageNum == 0) return;
+    applyStageSeparation(state, stageNum);
+    result.events |= (stageNum == 1) ? FLIGHT_EVENT_STAGE1_SEPARATION : FLIGHT_EVENT_STAGE2_SEPARATION;
+}
+
+FlightStepResult stepRocketFlight(RocketFlightState& state, const FlightConditions& conditions) {
+    FlightStepResult result;
+    result.events = 0;
+    result.thrust = 0.0f;
+    result.separationReason = "";
+    result.preSeparation = state;
+    result.poweredEnd = state;
+
+    float dt = conditions.step;
+
+    if (state.launching && state.fuel > 0) {
+        result.events |= FLIGHT_PHASE_POWERED;
+
+        // Different thrust for different stages, weaker as they go
+        result.thrust = STAGE_THRUST[state.stage == 1 ? 0 : state.stage == 2 ? 1 : 2];
+
+        state.fuel -= FUEL_BURN_RATE * dt; // Fuel consumption
+
+        // Apply wind effect (less effect at higher altitudes)
+        float altitude = state.y - 150.0f;
+        float windEffect = conditions.windSpeed * conditions.windDirection * 0.1f * (1.0f - altitude / 1000.0f);
+        state.x += windEffect * dt;
+
+        // Slight rotation due to wind
+        state.angle += windEffect * 0.5f * dt;
+
+        // Limit angle
+        if (state.angle > 10.0f) state.angle = 10.0f;
+        if (state.angle < -10.0f) state.angle = -10.0f;
+
+        // Thrust integration
+        MotionState motion = {state.y, state.velocity};
+        integrateMotion(motion, constantAcceleration(result.thrust), dt, conditions.integrator);
+        state.y = motion.position;
+        state.velocity = motion.velocity;
+
+        result.preSeparation = state;
+        separate(state, poweredSeparation(state, result.separationReason), result);
+        result.poweredEnd = state;
+
+        if (state.y > 1000) {
+            state.launched = true;
+            state.launching = false;
+            result.events |= FLIGHT_EVENT_MAX_ALTITUDE;
+        }
+    }
+    else if (state.launching && state.fuel <= 0) {
+        // Out of fuel but still launching (coasting)
+        // Reduced gravity at high altitude
+        result.events |= FLIGHT_PHASE_COASTING;
+
+        MotionState motion = {state.y, state.velocity};
+        integrateMotion(motion, constantAcceleration(COAST_ACCELERATION), dt, conditions.integrator);
+        state.y = motion.position;
+        state.velocity = motion.velocity;
+
+        result.preSeparation = state;
+        separate(state, coastingSeparation(state, result.separationReason), result);
+    }
+
+    // Apply gravity if not launching (falling back)
+    if (!state.launching && state.y > 150.0f) {
+        result.events |= FLIGHT_PHASE_FALLING;
+
+        MotionState motion = {state.y, state.velocity};
+        integrateMotion(motion, constantAcceleration(-0.05f), dt, conditions.integrator);
+        state.y = motion.position;
+        state.velocity = motion.velocity;
+
+        if (state.y <= 150.0f && state.velocity < -2.0f) {
+            result.events |= FLIGHT_EVENT_CRASHED;
+        }
+        else if (state.y <= 150.0f) {
+            // Soft landing
+            state.y = 150.0f;
+            state.velocity = 0.0f;
+            state.launching = false;
+            state.launched = false;
+            result.events |= FLIGHT_EVENT_LANDED;
+        }
+    }
+
+    return result;
+}
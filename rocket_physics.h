@@ -0,0 +1,89 @@
+// rocket_physics.h
+#ifndef ROCKET_PHYSICS_H
+#define ROCKET_PHYSICS_H
+
+#include "integrator.h"
+
+// ================== ROCKET FLIGHT STEP ==================
+// Everything one simulation tick of the rocket depends on, copied out of the
+// globals so the same step can drive both the live rocket and the predictor.
+struct RocketFlightState {
+    float x, y;
+    float velocity;
+    float angle;
+    float fuel;
+    int stage;
+    bool launching;
+    bool launched;
+    bool stage1Separated;
+    bool stage2Separated;
+};
+
+// Inputs that stay fixed for a tick
+struct FlightConditions {
+    float windSpeed;
+    float windDirection;
+    float step;
+    IntegratorType integrator;
+};
+
+// ================== FLIGHT CONSTANTS ==================
+// Shared by stepRocketFlight, the trajectory fan (trajectory_fan.cpp) and
+// the time-warp separation guard (ticksUntilSeparation), so the three
+// cannot drift apart. Altitudes are above the pad.
+const float STAGE_THRUST[3] = {0.12f, 0.09f, 0.06f}; // Stage 1, stage 2, payload
+const float FUEL_BURN_RATE = 0.4f;       // Fuel per unit of step while powered
+const float COAST_ACCELERATION = -0.02f; // Out of fuel, still launching
+
+// When stage n (index n - 1) separates, and what the separation does to
+// the rocket
+struct StageSeparationRule {
+    float normalAltitude;     // Normal separation: above this altitude,
+    float normalFuel;         // below this fuel
+    float normalVelocity;     // and faster than this
+    float emergencyFuel;      // Powered, below this fuel
+    float maxAltitude;        // Powered, above this altitude
+    float coastAltitude;      // Out of fuel, above this altitude
+    float nextFuel;           // Fuel of the next stage
+    float velocityRetention;  // Velocity kept through the separation
+};
+
+const StageSeparationRule STAGE_SEPARATION_RULES[2] = {
+    {250.0f, 50.0f, 3.0f, 10.0f, 400.0f, 200.0f, 100.0f, 0.95f},
+    {500.0f, 40.0f, 4.0f, 15.0f, 700.0f, 450.0f, 50.0f, 0.98f}
+};
+
+// Bit flags reported by stepRocketFlight
+enum FlightEventFlags {
+    FLIGHT_PHASE_POWERED = 1 << 0,
+    FLIGHT_PHASE_COASTING = 1 << 1,
+    FLIGHT_PHASE_FALLING = 1 << 2,
+    FLIGHT_EVENT_STAGE1_SEPARATION = 1 << 3,
+    FLIGHT_EVENT_STAGE2_SEPARATION = 1 << 4,
+    FLIGHT_EVENT_MAX_ALTITUDE = 1 << 5,
+    FLIGHT_EVENT_LANDED = 1 << 6,
+    FLIGHT_EVENT_CRASHED = 1 << 7
+};
+
+struct FlightStepResult {
+    int events;
+    float thrust;                      // Thrust applied this tick (0 when unpowered)
+    const char* separationReason;      // Why a separation fired, if one did
+    RocketFlightState preSeparation;   // State after the powered/coast phase, before any separation
+    RocketFlightState poweredEnd;      // State at the end of the powered phase (after separation)
+};
+
+// Detach the given stage: switch to the next stage's fuel and lose a little
+// velocity. Returns false if that stage was already gone.
+bool applyStageSeparation(RocketFlightState& state, int stageNum);
+
+// Advance the rocket by one tick. Has no side effects outside 'state' - the
+// caller reacts to the returned events (effects, messages, explosions).
+FlightStepResult stepRocketFlight(RocketFlightState& state, const FlightConditions& conditions);
+
+// Ground contact ends the prediction: nothing more can happen without input
+inline bool flightHasEnded(int events) {
+    return (events & (FLIGHT_EVENT_LANDED | FLIGHT_EVENT_CRASHED)) != 0;
+}
+
+#endif
@@ -0,0 +1,363 @@
+#include "scenario.h"
+#include "constants_config.h"
+#include <cerrno>
+#include <cmath>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#ifdef _WIN32
+#include <vector>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ========== DEFAULTS ==========
+ScenarioConfig defaultScenario() {
+    ScenarioConfig config;
+    config.launchPadX = LAUNCH_PAD_X;
+    config.rocketFuel = INITIAL_ROCKET_FUEL;
+    config.rocketStage = INITIAL_ROCKET_STAGE;
+    config.countdown = INITIAL_COUNTDOWN;
+    config.targetAltitude = INITIAL_TARGET_ALTITUDE;
+    config.targetVelocity = INITIAL_TARGET_VELOCITY;
+    config.cameraZoom = INITIAL_CAMERA_ZOOM;
+    config.cameraX = INITIAL_CAMERA_X;
+    config.cameraY = INITIAL_CAMERA_Y;
+    config.dayTime = INITIAL_DAY_TIME;
+    config.windSpeed = INITIAL_WIND_SPEED;
+    config.windDirection = INITIAL_WIND_DIRECTION;
+    config.simulationStep = DEFAULT_SIMULATION_STEP;
+    config.cloudCount = INITIAL_CLOUD_COUNT;
+    config.satelliteCount = INITIAL_SATELLITE_COUNT;
+    config.meteorCount = INITIAL_METEOR_COUNT;
+    config.starSeed = 0;
+    return config;
+}
+
+// ========== TEXT FORMAT ==========
+enum ScenarioFieldType {
+    SCENARIO_FLOAT,
+    SCENARIO_INT,
+    SCENARIO_UNSIGNED
+};
+
+// Values the simulation can run from; anything else is rejected. Floats
+// must also be finite.
+enum ScenarioRange {
+    RANGE_ANY,
+    RANGE_NON_NEGATIVE,  // Counts
+    RANGE_POSITIVE,      // Step sizes, zoom, divisors
+    RANGE_PERCENT,       // 0..100
+    RANGE_STAGE          // 1..3
+};
+
+struct ScenarioField {
+    const char* name;
+    ScenarioFieldType type;
+    size_t offset;
+    ScenarioRange range;
+};
+
+static const ScenarioField SCENARIO_FIELDS[] = {
+    {"launch_pad_x",    SCENARIO_FLOAT,    offsetof(ScenarioConfig, launchPadX),     RANGE_ANY},
+    {"rocket_fuel",     SCENARIO_FLOAT,    offsetof(ScenarioConfig, rocketFuel),     RANGE_PERCENT},
+    {"rocket_stage",    SCENARIO_INT,      offsetof(ScenarioConfig, rocketStage),    RANGE_STAGE},
+    {"countdown",       SCENARIO_INT,      offsetof(ScenarioConfig, countdown),      RANGE_ANY},
+    {"target_altitude", SCENARIO_FLOAT,    offsetof(ScenarioConfig, targetAltitude), RANGE_POSITIVE},
+    {"target_velocity", SCENARIO_FLOAT,    offsetof(ScenarioConfig, targetVelocity), RANGE_POSITIVE},
+    {"camera_zoom",     SCENARIO_FLOAT,    offsetof(ScenarioConfig, cameraZoom),     RANGE_POSITIVE},
+    {"camera_x",        SCENARIO_FLOAT,    offsetof(ScenarioConfig, cameraX),        RANGE_ANY},
+    {"camera_y",        SCENARIO_FLOAT,    offsetof(ScenarioConfig, cameraY),        RANGE_ANY},
+    {"day_time",        SCENARIO_FLOAT,    offsetof(ScenarioConfig, dayTime),        RANGE_ANY},
+    {"wind_speed",      SCENARIO_FLOAT,    offsetof(ScenarioConfig, windSpeed),      RANGE_ANY},
+    {"wind_direction",  SCENARIO_FLOAT,    offsetof(ScenarioConfig, windDirection),  RANGE_ANY},
+    {"simulation_step", SCENARIO_FLOAT,    offsetof(ScenarioConfig, simulationStep), RANGE_POSITIVE},
+    {"cloud_count",     SCENARIO_INT,      offsetof(ScenarioConfig, cloudCount),     RANGE_NON_NEGATIVE},
+    {"satellite_count", SCENARIO_INT,      offsetof(ScenarioConfig, satelliteCount), RANGE_NON_NEGATIVE},
+    {"meteor_count",    SCENARIO_INT,      offsetof(ScenarioConfig, meteorCount),    RANGE_NON_NEGATIVE},
+    {"star_seed",       SCENARIO_UNSIGNED, offsetof(ScenarioConfig, starSeed),       RANGE_ANY}
+};
+static const int SCENARIO_FIELD_COUNT = sizeof(SCENARIO_FIELDS) / sizeof(SCENARIO_FIELDS[0]);
+
+static std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) return "";
+    size_t last = text.find_last_not_of(" \t\r\n");
+    return text.substr(first, last - first + 1);
+}
+
+static const char* rangeDescription(ScenarioRange range) {
+    switch (range) {
+        case RANGE_NON_NEGATIVE: return "at least 0";
+        case RANGE_POSITIVE: return "greater than 0";
+        case RANGE_PERCENT: return "0 to 100";
+        case RANGE_STAGE: return "1 to 3";
+        default: return "a finite number";
+    }
+}
+
+static bool fieldInRange(const ScenarioField& field, const ScenarioConfig& config) {
+    const char* base = reinterpret_cast<const char*>(&config) + field.offset;
+    double value = 0.0;
+    if (field.type == SCENARIO_FLOAT) {
+        float parsed;
+        std::memcpy(&parsed, base, sizeof(parsed));
+        if (!std::isfinite(parsed)) return false;
+        value = parsed;
+    } else if (field.type == SCENARIO_INT) {
+        int parsed;
+        std::memcpy(&parsed, base, sizeof(parsed));
+        value = parsed;
+    } else {
+        return true;
+    }
+
+    switch (field.range) {
+        case RANGE_NON_NEGATIVE: return value >= 0.0;
+        case RANGE_POSITIVE: return value > 0.0;
+        case RANGE_PERCENT: return value >= 0.0 && value <= 100.0;
+        case RANGE_STAGE: return value >= 1.0 && value <= 3.0;
+        default: return true;
+    }
+}
+
+bool checkScenarioRanges(const ScenarioConfig& config, const std::string& where) {
+    for (int i = 0; i < SCENARIO_FIELD_COUNT; i++) {
+        if (!fieldInRange(SCENARIO_FIELDS[i], config)) {
+            std::cout << where << ": bad value for " << SCENARIO_FIELDS[i].name
+                      << " (must be " << rangeDescription(SCENARIO_FIELDS[i].range) << ")" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool parseField(const ScenarioField& field, const std::string& value, ScenarioConfig& config) {
+    char* base = reinterpret_cast<char*>(&config) + field.offset;
+    const char* text = value.c_str();
+    char* end = 0;
+    switch (field.type) {
+        case SCENARIO_FLOAT: {
+            float parsed = std::strtof(text, &end);
+            std::memcpy(base, &parsed, sizeof(parsed));
+            break;
+        }
+        case SCENARIO_INT: {
+            int parsed = (int)std::strtol(text, &end, 10);
+            std::memcpy(base, &parsed, sizeof(parsed));
+            break;
+        }
+        case SCENARIO_UNSIGNED: {
+            unsigned int parsed = (unsigned int)std::strtoul(text, &end, 0);
+            std::memcpy(base, &parsed, sizeof(parsed));
+            break;
+        }
+    }
+    return end != text && *end == '\0';
+}
+
+bool loadScenarioText(const char* path, ScenarioConfig& config) {
+    FILE* file = std::fopen(path, "r");
+    if (!file) {
+        std::cout << "Scenario: cannot open " << path << std::endl;
+        return false;
+    }
+
+    ScenarioConfig parsed = defaultScenario();
+    char buffer[256];
+    int lineNumber = 0;
+    bool ok = true;
+    while (ok && std::fgets(buffer, sizeof(buffer), file)) {
+        lineNumber++;
+        std::string line = buffer;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        size_t equals = line.find('=');
+        std::string name = trim(line.substr(0, equals));
+        std::string value = (equals == std::string::npos) ? "" : trim(line.substr(equals + 1));
+
+        const ScenarioField* field = 0;
+        for (int i = 0; i < SCENARIO_FIELD_COUNT; i++) {
+            if (name == SCENARIO_FIELDS[i].name) field = &SCENARIO_FIELDS[i];
+        }
+        if (!field) {
+            std::cout << path << ":" << lineNumber << ": unknown setting '" << name << "'" << std::endl;
+            ok = false;
+        } else if (!parseField(*field, value, parsed)) {
+            std::cout << path << ":" << lineNumber << ": bad value for " << name << std::endl;
+            ok = false;
+        } else if (!fieldInRange(*field, parsed)) {
+            std::cout << path << ":" << lineNumber << ": bad value for " << name
+                      << " (must be " << rangeDescription(field->range) << ")" << std::endl;
+            ok = false;
+        }
+    }
+    std::fclose(file);
+
+    if (ok) config = parsed;
+    return ok;
+}
+
+// ========== BINARY PACKS ==========
+struct ScenarioPackHeader {
+    char magic[4];
+    unsigned int version;
+    unsigned int recordSize;  // sizeof(ScenarioConfig) of the writer
+    unsigned int count;
+};
+
+static const char SCENARIO_PACK_MAGIC[4] = {'R', 'K', 'S', 'C'};
+static const unsigned int SCENARIO_PACK_VERSION = 1;
+
+bool writeScenarioPack(const char* path, const ScenarioConfig* scenarios, int count) {
+    FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        std::cout << "Scenario pack: cannot create " << path << std::endl;
+        return false;
+    }
+
+    ScenarioPackHeader header;
+    std::memcpy(header.magic, SCENARIO_PACK_MAGIC, sizeof(header.magic));
+    header.version = SCENARIO_PACK_VERSION;
+    header.recordSize = sizeof(ScenarioConfig);
+    header.count = (unsigned int)count;
+
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(scenarios, sizeof(ScenarioConfig), count, file) == (size_t)count;
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) std::cout << "Scenario pack: write to " << path << " failed" << std::endl;
+    return ok;
+}
+
+static void* mapFile(const char* path, size_t& size) {
+#ifdef _WIN32
+    // No mmap here: read the whole file instead
+    FILE* file = std::fopen(path, "rb");
+    if (!file) return 0;
+    std::fseek(file, 0, SEEK_END);
+    long length = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    void* data = (length > 0) ? std::malloc(length) : 0;
+    if (data && std::fread(data, 1, length, file) != (size_t)length) {
+        std::free(data);
+        data = 0;
+    }
+    std::fclose(file);
+    size = data ? (size_t)length : 0;
+    return data;
+#else
+    int descriptor = open(path, O_RDONLY);
+    if (descriptor < 0) return 0;
+    struct stat info;
+    void* data = 0;
+    if (fstat(descriptor, &info) == 0 && info.st_size > 0) {
+        data = mmap(0, info.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (data == MAP_FAILED) data = 0;
+    }
+    close(descriptor);
+    size = data ? (size_t)info.st_size : 0;
+    return data;
+#endif
+}
+
+static void unmapFile(void* data, size_t size) {
+#ifdef _WIN32
+    (void)size;
+    std::free(data);
+#else
+    munmap(data, size);
+#endif
+}
+
+bool openScenarioPack(const char* path, ScenarioPack& pack) {
+    pack.scenarios = 0;
+    pack.count = 0;
+    pack.mapping = mapFile(path, pack.mappingSize);
+    if (!pack.mapping) {
+        std::cout << "Scenario pack: cannot open " << path << std::endl;
+        return false;
+    }
+
+    const ScenarioPackHeader* header = static_cast<const ScenarioPackHeader*>(pack.mapping);
+    bool valid = pack.mappingSize >= sizeof(ScenarioPackHeader) &&
+                 std::memcmp(header->magic, SCENARIO_PACK_MAGIC, sizeof(header->magic)) == 0 &&
+                 header->version == SCENARIO_PACK_VERSION &&
+                 header->recordSize == sizeof(ScenarioConfig) &&
+                 header->count <= (unsigned int)INT_MAX &&
+                 pack.mappingSize >= sizeof(ScenarioPackHeader) + (size_t)header->count * sizeof(ScenarioConfig);
+    if (!valid) {
+        std::cout << "Scenario pack: " << path << " is not a compatible pack" << std::endl;
+        closeScenarioPack(pack);
+        return false;
+    }
+
+    pack.scenarios = reinterpret_cast<const ScenarioConfig*>(header + 1);
+    pack.count = (int)header->count;
+    return true;
+}
+
+void closeScenarioPack(ScenarioPack& pack) {
+    if (pack.mapping) unmapFile(pack.mapping, pack.mappingSize);
+    pack.mapping = 0;
+    pack.mappingSize = 0;
+    pack.scenarios = 0;
+    pack.count = 0;
+}
+
+// ========== LOADING ==========
+static bool endsWith(const std::string& text, const char* suffix) {
+    size_t length = std::strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+bool loadScenario(const char* path, ScenarioConfig& config) {
+    std::string file = path;
+    bool indexed = false;
+    unsigned long index = 0;
+
+    // "pack.rks:12" selects entry 12
+    size_t colon = file.rfind(':');
+    if (colon != std::string::npos && colon + 1 < file.size() &&
+        file.find_first_not_of("0123456789", colon + 1) == std::string::npos) {
+        errno = 0;
+        index = std::strtoul(file.c_str() + colon + 1, 0, 10);
+        if (errno == ERANGE) {
+            std::cout << "Scenario: entry number in " << path << " is too large" << std::endl;
+            return false;
+        }
+        indexed = true;
+        file.erase(colon);
+    }
+
+    if (!endsWith(file, SCENARIO_PACK_EXTENSION)) {
+        if (indexed) {
+            std::cout << "Scenario: " << file << " is not a pack, it has no entry " << index << std::endl;
+            return false;
+        }
+        return loadScenarioText(file.c_str(), config);
+    }
+
+    ScenarioPack pack;
+    if (!openScenarioPack(file.c_str(), pack)) return false;
+    bool ok = pack.count > 0 && index < (unsigned long)pack.count;
+    if (ok) {
+        // Packs are written by tools, but still hold only runnable values
+        ok = checkScenarioRanges(pack.scenarios[index],
+                                 "Scenario pack: " + file + " entry " + std::to_string(index));
+        if (ok) config = pack.scenarios[index];
+    } else {
+        std::cout << "Scenario pack: " << file << " has no entry " << index << std::endl;
+    }
+    closeScenarioPack(pack);
+    return ok;
+}
@@ -0,0 +1,65 @@
+// scenario.h
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <cstddef>
+#include <string>
+
+// ================== SCENARIO CONFIGURATION ==================
+// Start conditions of a run, one flat block of 4-byte fields. The defaults
+// come from constants_config.h; a scenario file overrides any of them.
+// Text files hold "name = value" lines ('#' starts a comment). Scenario
+// packs are the binary form: a header followed by the raw blocks, mapped
+// straight into memory so batch runs can pick any of thousands of
+// scenarios without parsing.
+struct ScenarioConfig {
+    float launchPadX;
+    float rocketFuel;
+    int rocketStage;
+    int countdown;
+    float targetAltitude;
+    float targetVelocity;
+    float cameraZoom;
+    float cameraX, cameraY;
+    float dayTime;
+    float windSpeed;
+    float windDirection;
+    float simulationStep;
+    int cloudCount;
+    int satelliteCount;
+    int meteorCount;
+    unsigned int starSeed;  // 0: pick a new seed every run
+};
+
+ScenarioConfig defaultScenario();
+
+// Parse a text scenario on top of the defaults. Errors, including values
+// the simulation cannot run from (stage outside 1..3, fuel outside
+// 0..100, negative counts, a step, zoom or target that is not positive,
+// NaN or infinity), are reported with their line number and leave
+// 'config' untouched.
+bool loadScenarioText(const char* path, ScenarioConfig& config);
+
+// Check every field of 'config' against the range the simulation can run
+// from. The first bad field is reported as "<where>: bad value for ...".
+bool checkScenarioRanges(const ScenarioConfig& config, const std::string& where);
+
+// Write 'count' scenarios as a pack (native byte order)
+bool writeScenarioPack(const char* path, const ScenarioConfig* scenarios, int count);
+
+// A mapped pack; 'scenarios' points into the mapping
+struct ScenarioPack {
+    const ScenarioConfig* scenarios;
+    int count;
+    void* mapping;
+    size_t mappingSize;
+};
+
+bool openScenarioPack(const char* path, ScenarioPack& pack);
+void closeScenarioPack(ScenarioPack& pack);
+
+// Load 'path' into 'config': a pack ("runs.rks", "runs.rks:12" for entry
+// 12) or a text file (which takes no entry number)
+bool loadScenario(const char* path, ScenarioConfig& config);
+
+#endif
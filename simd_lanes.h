@@ -0,0 +1,110 @@
+// simd_lanes.h
+#ifndef SIMD_LANES_H
+#define SIMD_LANES_H
+
+// ================== FOUR-WIDE FLOAT LANES ==================
+// Small wrapper over SSE2 with a plain scalar fallback, so lane-parallel
+// code is written once and builds on any target.
+// Masks are all-ones/all-zero lanes with SSE2 and 1/0 in the scalar fallback;
+// only the helpers below look at their representation.
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+typedef __m128 Lanes;
+
+static inline Lanes splat(float v) { return _mm_set1_ps(v); }
+static inline Lanes loadLanes(const float* p) { return _mm_loadu_ps(p); }
+static inline void storeLanes(float* p, Lanes a) { _mm_storeu_ps(p, a); }
+static inline Lanes add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+static inline Lanes sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+static inline Lanes mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+static inline Lanes divide(Lanes a, Lanes b) { return _mm_div_ps(a, b); }
+static inline Lanes minLanes(Lanes a, Lanes b) { return _mm_min_ps(a, b); }
+static inline Lanes maxLanes(Lanes a, Lanes b) { return _mm_max_ps(a, b); }
+static inline Lanes truncateLanes(Lanes a) { return _mm_cvtepi32_ps(_mm_cvttps_epi32(a)); }
+static inline Lanes greater(Lanes a, Lanes b) { return _mm_cmpgt_ps(a, b); }
+static inline Lanes less(Lanes a, Lanes b) { return _mm_cmplt_ps(a, b); }
+static inline Lanes lessEqual(Lanes a, Lanes b) { return _mm_cmple_ps(a, b); }
+static inline Lanes equal(Lanes a, Lanes b) { return _mm_cmpeq_ps(a, b); }
+static inline Lanes maskAnd(Lanes a, Lanes b) { return _mm_and_ps(a, b); }
+static inline Lanes maskOr(Lanes a, Lanes b) { return _mm_or_ps(a, b); }
+static inline Lanes maskAndNot(Lanes a, Lanes b) { return _mm_andnot_ps(b, a); } // a & ~b
+static inline Lanes maskFrom(const bool* flags) {
+    return _mm_castsi128_ps(_mm_set_epi32(flags[3] ? -1 : 0, flags[2] ? -1 : 0,
+                                          flags[1] ? -1 : 0, flags[0] ? -1 : 0));
+}
+static inline Lanes select(Lanes mask, Lanes a, Lanes b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+static inline int laneBits(Lanes mask) { return _mm_movemask_ps(mask); }
+static inline Lanes rsqrtLanes(Lanes a) { return _mm_rsqrt_ps(a); } // ~12 bits
+
+#else
+#include <cmath>
+
+struct Lanes { float v[4]; };
+
+static inline Lanes splat(float v) { Lanes r = {{v, v, v, v}}; return r; }
+static inline Lanes loadLanes(const float* p) { Lanes r = {{p[0], p[1], p[2], p[3]}}; return r; }
+static inline void storeLanes(float* p, Lanes a) { for (int i = 0; i < 4; i++) p[i] = a.v[i]; }
+
+#define LANE_OP(name, expr) \
+    static inline Lanes name(Lanes a, Lanes b) { \
+        Lanes r; \
+        for (int i = 0; i < 4; i++) r.v[i] = (expr); \
+        return r; \
+    }
+LANE_OP(add, a.v[i] + b.v[i])
+LANE_OP(sub, a.v[i] - b.v[i])
+LANE_OP(mul, a.v[i] * b.v[i])
+LANE_OP(divide, a.v[i] / b.v[i])
+LANE_OP(minLanes, a.v[i] < b.v[i] ? a.v[i] : b.v[i])
+LANE_OP(maxLanes, a.v[i] > b.v[i] ? a.v[i] : b.v[i])
+LANE_OP(greater, a.v[i] > b.v[i] ? 1.0f : 0.0f)
+LANE_OP(less, a.v[i] < b.v[i] ? 1.0f : 0.0f)
+LANE_OP(lessEqual, a.v[i] <= b.v[i] ? 1.0f : 0.0f)
+LANE_OP(equal, a.v[i] == b.v[i] ? 1.0f : 0.0f)
+LANE_OP(maskAnd, (a.v[i] != 0.0f && b.v[i] != 0.0f) ? 1.0f : 0.0f)
+LANE_OP(maskOr, (a.v[i] != 0.0f || b.v[i] != 0.0f) ? 1.0f : 0.0f)
+LANE_OP(maskAndNot, (a.v[i] != 0.0f && b.v[i] == 0.0f) ? 1.0f : 0.0f)
+#undef LANE_OP
+
+static inline Lanes truncateLanes(Lanes a) {
+    Lanes r;
+    for (int i = 0; i < 4; i++) r.v[i] = (float)(int)a.v[i];
+    return r;
+}
+static inline Lanes maskFrom(const bool* flags) {
+    Lanes r;
+    for (int i = 0; i < 4; i++) r.v[i] = flags[i] ? 1.0f : 0.0f;
+    return r;
+}
+static inline Lanes select(Lanes mask, Lanes a, Lanes b) {
+    Lanes r;
+    for (int i = 0; i < 4; i++) r.v[i] = mask.v[i] != 0.0f ? a.v[i] : b.v[i];
+    return r;
+}
+static inline int laneBits(Lanes mask) {
+    int bits = 0;
+    for (int i = 0; i < 4; i++) if (mask.v[i] != 0.0f) bits |= 1 << i;
+    return bits;
+}
+static inline Lanes rsqrtLanes(Lanes a) {
+    Lanes r;
+    for (int i = 0; i < 4; i++) r.v[i] = 1.0f / std::sqrt(a.v[i]);
+    return r;
+}
+
+#endif
+
+// ========== DERIVED ==========
+static inline Lanes laneIndices() {
+    const float indices[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+    return loadLanes(indices);
+}
+static inline Lanes absLanes(Lanes a) { return maxLanes(a, sub(splat(0.0f), a)); }
+static inline Lanes clampLanes(Lanes a, float low, float high) {
+    return minLanes(maxLanes(a, splat(low)), splat(high));
+}
+
+#endif
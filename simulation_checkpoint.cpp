@@ -0,0 +1,218 @@
+#include "simulation_checkpoint.h"
+#include "scenario.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+struct CheckpointHeader {
+    char magic[4];
+    unsigned int version;
+    unsigned int layout;       // Signature of the field names, order and sizes
+    unsigned int payloadSize;  // Bytes after the header
+};
+
+static const char CHECKPOINT_MAGIC[4] = {'R', 'K', 'C', 'P'};
+static const unsigned int CHECKPOINT_VERSION = 2;
+
+// ========== FIELD ENCODING ==========
+// One overload set per encoding: raw values, vectors of raw values, and
+// RocketStage (raw fields plus its debris vector)
+struct CheckpointReader {
+    const unsigned char* data;
+    size_t size;
+    size_t offset;
+    bool ok;
+};
+
+static void putBytes(std::vector<unsigned char>& out, const void* bytes, size_t count) {
+    const unsigned char* begin = static_cast<const unsigned char*>(bytes);
+    out.insert(out.end(), begin, begin + count);
+}
+
+static bool getBytes(CheckpointReader& in, void* bytes, size_t count) {
+    if (!in.ok || count > in.size - in.offset) {
+        in.ok = false;
+        return false;
+    }
+    std::memcpy(bytes, in.data + in.offset, count);
+    in.offset += count;
+    return true;
+}
+
+template <typename T>
+static void putField(std::vector<unsigned char>& out, const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "checkpoint fields must be raw values or vectors");
+    putBytes(out, &value, sizeof(T));
+}
+
+template <typename T>
+static void getField(CheckpointReader& in, T& value) {
+    getBytes(in, &value, sizeof(T));
+}
+
+template <typename T>
+static unsigned int fieldLayout(const T*) {
+    return sizeof(T);
+}
+
+template <typename T>
+static void putField(std::vector<unsigned char>& out, const std::vector<T>& values) {
+    static_assert(std::is_trivially_copyable<T>::value, "checkpoint vectors must hold raw values");
+    unsigned int count = (unsigned int)values.size();
+    putBytes(out, &count, sizeof(count));
+    if (count > 0) putBytes(out, values.data(), count * sizeof(T));
+}
+
+template <typename T>
+static void getField(CheckpointReader& in, std::vector<T>& values) {
+    unsigned int count = 0;
+    if (!getBytes(in, &count, sizeof(count))) return;
+    if (count > (in.size - in.offset) / sizeof(T)) {
+        in.ok = false;
+        return;
+    }
+    values.resize(count);
+    if (count > 0) getBytes(in, values.data(), count * sizeof(T));
+}
+
+template <typename T>
+static unsigned int fieldLayout(const std::vector<T>*) {
+    return 0x10000u + sizeof(T);
+}
+
+// FNV-1a of a field name, so swapping two fields of the same size still
+// changes the layout signature
+static unsigned int fieldNameHash(const char* name) {
+    unsigned int hash = 2166136261u;
+    for (; *name; name++) {
+        hash ^= (unsigned char)*name;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+#define ROCKET_STAGE_FIELDS(X) \
+    X(x) X(y) X(velocity) X(angle) X(fuel) X(active) X(separated) X(falling) \
+    X(separationTime) X(debris) X(width) X(height)
+
+static void putField(std::vector<unsigned char>& out, const RocketStage& stage) {
+#define PUT_STAGE_FIELD(name) putField(out, stage.name);
+    ROCKET_STAGE_FIELDS(PUT_STAGE_FIELD)
+#undef PUT_STAGE_FIELD
+}
+
+static void getField(CheckpointReader& in, RocketStage& stage) {
+#define GET_STAGE_FIELD(name) getField(in, stage.name);
+    ROCKET_STAGE_FIELDS(GET_STAGE_FIELD)
+#undef GET_STAGE_FIELD
+}
+
+static unsigned int fieldLayout(const RocketStage*) {
+    unsigned int layout = 0;
+#define STAGE_FIELD_LAYOUT(name) \
+    layout = (layout * 31 + fieldNameHash(#name)) * 31 + fieldLayout(static_cast<const decltype(RocketStage::name)*>(0));
+    ROCKET_STAGE_FIELDS(STAGE_FIELD_LAYOUT)
+#undef STAGE_FIELD_LAYOUT
+    return layout;
+}
+
+#undef ROCKET_STAGE_FIELDS
+
+// Changes whenever a SIMULATION_STATE or RocketStage field is added,
+// removed, renamed, reordered or resized, so a stale checkpoint is rejected
+// even if CHECKPOINT_VERSION was not bumped. Other structs saved raw
+// (SmokeParticle, ScenarioConfig, ...) only contribute their size: bump
+// CHECKPOINT_VERSION when reordering their fields.
+static unsigned int checkpointLayout() {
+    unsigned int layout = 0;
+#define FIELD_LAYOUT(type, name) \
+    layout = (layout * 31 + fieldNameHash(#name)) * 31 + fieldLayout(static_cast<const type*>(0));
+    SIMULATION_STATE(FIELD_LAYOUT)
+#undef FIELD_LAYOUT
+    return layout;
+}
+
+// ========== CHECKPOINTS ==========
+void writeCheckpoint(const SimulationSnapshot& snapshot, std::vector<unsigned char>& out) {
+    out.clear();
+    CheckpointHeader header;
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_VERSION;
+    header.layout = checkpointLayout();
+    header.payloadSize = 0;
+    putBytes(out, &header, sizeof(header));
+
+#define PUT_FIELD(type, name) putField(out, snapshot.name);
+    SIMULATION_STATE(PUT_FIELD)
+#undef PUT_FIELD
+
+    header.payloadSize = (unsigned int)(out.size() - sizeof(header));
+    std::memcpy(out.data(), &header, sizeof(header));
+}
+
+bool readCheckpoint(const unsigned char* data, size_t size, SimulationSnapshot& snapshot) {
+    CheckpointHeader header;
+    if (size < sizeof(header)) return false;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != CHECKPOINT_VERSION ||
+        header.layout != checkpointLayout() ||
+        header.payloadSize != size - sizeof(header)) {
+        return false;
+    }
+
+    CheckpointReader in;
+    in.data = data;
+    in.size = size;
+    in.offset = sizeof(header);
+    in.ok = true;
+#define GET_FIELD(type, name) getField(in, snapshot.name);
+    SIMULATION_STATE(GET_FIELD)
+#undef GET_FIELD
+    return in.ok && in.offset == size;
+}
+
+bool saveCheckpoint(const char* path, const SimulationSnapshot& snapshot) {
+    std::vector<unsigned char> bytes;
+    writeCheckpoint(snapshot, bytes);
+
+    FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        std::cout << "Checkpoint: cannot create " << path << std::endl;
+        return false;
+    }
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) std::cout << "Checkpoint: write to " << path << " failed" << std::endl;
+    return ok;
+}
+
+bool loadCheckpoint(const char* path, SimulationSnapshot& snapshot) {
+    FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        std::cout << "Checkpoint: cannot open " << path << std::endl;
+        return false;
+    }
+    std::fseek(file, 0, SEEK_END);
+    long length = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    std::vector<unsigned char> bytes(length > 0 ? (size_t)length : 0);
+    bool ok = length > 0 && std::fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    std::fclose(file);
+
+    if (!ok || !readCheckpoint(bytes.data(), bytes.size(), snapshot)) {
+        std::cout << "Checkpoint: " << path << " is not a compatible checkpoint" << std::endl;
+        return false;
+    }
+
+    // Hold a checkpoint to the same ranges as a scenario file
+    std::string where = std::string("Checkpoint: ") + path;
+    if (!checkScenarioRanges(snapshot.scenario, where)) return false;
+    if (snapshot.rocketStage < 1 || snapshot.rocketStage > 3) {
+        std::cout << where << ": bad value for rocketStage (must be 1 to 3)" << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,34 @@
+// simulation_checkpoint.h
+#ifndef SIMULATION_CHECKPOINT_H
+#define SIMULATION_CHECKPOINT_H
+
+#include "simulation_snapshot.h"
+#include <cstddef>
+#include <vector>
+
+// ================== SIMULATION CHECKPOINTS ==================
+// A SimulationSnapshot as one contiguous, versioned byte block: a header
+// (magic, version, field layout signature, payload size) followed by the
+// SIMULATION_STATE fields in order. Plain fields are copied raw; vectors
+// are an element count followed by the raw elements. No parsing and no
+// per-field allocation, so writing or reading takes microseconds and one
+// snapshot can seed any number of what-if runs. Native byte order.
+//
+// Scheduled simulation callbacks (camera switch timers) hold function
+// pointers and are not saved.
+
+// Replace 'out' with the checkpoint of 'snapshot'. 'out' keeps its
+// capacity, so repeated checkpoints do not allocate.
+void writeCheckpoint(const SimulationSnapshot& snapshot, std::vector<unsigned char>& out);
+
+// Decode a checkpoint. Returns false for a foreign, older or truncated
+// block; 'snapshot' is only meaningful when it returns true.
+bool readCheckpoint(const unsigned char* data, size_t size, SimulationSnapshot& snapshot);
+
+// The same through a file. Errors are reported on stdout. A loaded
+// checkpoint is also held to the scenario ranges (checkScenarioRanges) and
+// a rocket stage of 1..3.
+bool saveCheckpoint(const char* path, const SimulationSnapshot& snapshot);
+bool loadCheckpoint(const char* path, SimulationSnapshot& snapshot);
+
+#endif
@@ -0,0 +1,39 @@
+#include "simulation_snapshot.h"
+
+#define CAPTURE_FIELD(type, name) snapshot.name = name;
+#define APPLY_FIELD(type, name) name = snapshot.name;
+
+void captureSimulationSnapshot(SimulationSnapshot& snapshot) {
+    SIMULATION_STATE(CAPTURE_FIELD)
+}
+
+void applySimulationSnapshot(const SimulationSnapshot& snapshot) {
+    SIMULATION_STATE(APPLY_FIELD)
+}
+
+#undef CAPTURE_FIELD
+#undef APPLY_FIELD
+
+RocketFlightState snapshotFlightState(const SimulationSnapshot& snapshot) {
+    RocketFlightState state;
+    state.x = snapshot.rocketX;
+    state.y = snapshot.rocketY;
+    state.velocity = snapshot.rocketVelocity;
+    state.angle = snapshot.rocketAngle;
+    state.fuel = snapshot.rocketFuel;
+    state.stage = snapshot.rocketStage;
+    state.launching = snapshot.rocketLaunching;
+    state.launched = snapshot.rocketLaunched;
+    state.stage1Separated = snapshot.stage1Separated;
+    state.stage2Separated = snapshot.stage2Separated;
+    return state;
+}
+
+FlightConditions snapshotFlightConditions(const SimulationSnapshot& snapshot) {
+    FlightConditions conditions;
+    conditions.windSpeed = snapshot.windSpeed;
+    conditions.windDirection = snapshot.windDirection;
+    conditions.step = snapshot.simulationStep;
+    conditions.integrator = snapshot.currentIntegrator;
+    return conditions;
+}
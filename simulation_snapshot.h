@@ -0,0 +1,96 @@
+// simulation_snapshot.h
+#ifndef SIMULATION_SNAPSHOT_H
+#define SIMULATION_SNAPSHOT_H
+
+#include "globals_extern.h"
+
+// ================== SIMULATION STATE ==================
+// Every global the simulation thread owns and the renderer draws from.
+// The simulation thread advances the globals and publishes a copy of them
+// after each frame; display() draws from the newest copy it has been
+// handed and never reads the globals, so anything the scene shows must be
+// listed here. Render-only caches (prediction, fan, starfield tiles,
+// terrain chunks) are not part of the state.
+#define SIMULATION_STATE(X) \
+    X(float, rocketX) \
+    X(float, rocketY) \
+    X(float, rocketVelocity) \
+    X(float, rocketAngle) \
+    X(bool, rocketLaunched) \
+    X(bool, rocketLaunching) \
+    X(bool, rocketExploded) \
+    X(float, rocketFuel) \
+    X(int, rocketStage) \
+    X(int, countdown) \
+    X(float, altitude) \
+    X(float, velocity) \
+    X(float, acceleration) \
+    X(RocketStage, stage1) \
+    X(RocketStage, stage2) \
+    X(RocketStage, stage3) \
+    X(bool, stage1Separated) \
+    X(bool, stage2Separated) \
+    X(bool, stage1Falling) \
+    X(bool, stage2Falling) \
+    X(float, stage1FallTime) \
+    X(float, stage2FallTime) \
+    X(IntegratorType, currentIntegrator) \
+    X(float, simulationStep) \
+    X(unsigned long, simulationTick) \
+    X(unsigned long long, simulationRandomCounter) \
+    X(int, timeWarpLevel) \
+    X(bool, visualEffectsEnabled) \
+    X(int, flightEventCount) \
+    X(float, cameraZoom) \
+    X(float, cameraX) \
+    X(float, cameraY) \
+    X(bool, cameraFollowRocket) \
+    X(bool, cameraShake) \
+    X(float, shakeIntensity) \
+    X(CameraMode, currentCameraMode) \
+    X(float, cameraTargetX) \
+    X(float, cameraTargetY) \
+    X(float, cameraTargetZoom) \
+    X(bool, lightOn) \
+    X(float, flameSize) \
+    X(float, flameIntensity) \
+    X(int, lightTimer) \
+    X(float, dayTime) \
+    X(bool, dayNightCycle) \
+    X(float, windSpeed) \
+    X(float, windDirection) \
+    X(bool, showStats) \
+    X(bool, showGrid) \
+    X(bool, showTrajectory) \
+    X(TrajectoryHistory, trajectoryHistory) \
+    X(GameState, currentState) \
+    X(std::vector<SmokeParticle>, smokeParticles) \
+    X(unsigned int, nextParticleId) \
+    X(std::vector<Cloud>, clouds) \
+    X(std::vector<ExplosionParticle>, explosionParticles) \
+    X(std::vector<Satellite>, satellites) \
+    X(std::vector<Meteor>, meteors) \
+    X(ScenarioConfig, scenario) \
+    X(float, targetAltitude) \
+    X(float, targetVelocity) \
+    X(bool, missionSuccess)
+
+#define SIMULATION_SNAPSHOT_FIELD(type, name) type name;
+
+struct SimulationSnapshot {
+    SIMULATION_STATE(SIMULATION_SNAPSHOT_FIELD)
+};
+
+#undef SIMULATION_SNAPSHOT_FIELD
+
+// Simulation thread: copy the globals into 'snapshot' / from 'snapshot'.
+// Vectors keep their capacity, so steady-state copies do not allocate.
+void captureSimulationSnapshot(SimulationSnapshot& snapshot);
+void applySimulationSnapshot(const SimulationSnapshot& snapshot);
+
+// The rocket and flight conditions of 'snapshot', as the trajectory
+// predictors take them (currentRocketFlightState for a snapshot)
+RocketFlightState snapshotFlightState(const SimulationSnapshot& snapshot);
+FlightConditions snapshotFlightConditions(const SimulationSnapshot& snapshot);
+
+#endif
@@ -0,0 +1,206 @@
+#include "main_includes.h"
+#include "simulation_thread.h"
+#include "simulation_snapshot.h"
+#include "simulation_checkpoint.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// ========== SNAPSHOT TRIPLE BUFFER ==========
+// Three slots: the simulation writes 'backSlot', the renderer reads
+// 'frontSlot', and the third is parked in 'sharedSlot'. Publishing and
+// consuming each swap their slot with the shared one, so neither side ever
+// touches a slot the other is using. SNAPSHOT_FRESH marks a shared slot the
+// renderer has not picked up yet.
+static const int SNAPSHOT_FRESH = 4;
+static const int SNAPSHOT_INDEX_MASK = 3;
+
+static SimulationSnapshot snapshotSlots[3];
+static std::atomic<int> sharedSlot(1);
+static int backSlot = 0;   // Simulation thread only
+static int frontSlot = 2;  // Render thread only
+
+static void publishSnapshot() {
+    captureSimulationSnapshot(snapshotSlots[backSlot]);
+    backSlot = sharedSlot.exchange(backSlot | SNAPSHOT_FRESH, std::memory_order_acq_rel) & SNAPSHOT_INDEX_MASK;
+}
+
+const SimulationSnapshot& latestSnapshot(bool& fresh) {
+    fresh = (sharedSlot.load(std::memory_order_acquire) & SNAPSHOT_FRESH) != 0;
+    if (fresh) {
+        frontSlot = sharedSlot.exchange(frontSlot, std::memory_order_acq_rel) & SNAPSHOT_INDEX_MASK;
+    }
+    return snapshotSlots[frontSlot];
+}
+
+// ========== INPUT QUEUE ==========
+// Single producer (GLUT thread), single consumer (simulation thread).
+// Indices grow without wrapping the array; the difference is the fill.
+struct InputEvent {
+    InputEventType type;
+    int key;
+};
+
+static InputEvent inputQueue[INPUT_QUEUE_CAPACITY];
+static std::atomic<unsigned int> inputHead(0); // Next event to consume
+static std::atomic<unsigned int> inputTail(0); // Next free entry
+
+void postInputEvent(InputEventType type, int key) {
+    unsigned int tail = inputTail.load(std::memory_order_relaxed);
+    if (tail - inputHead.load(std::memory_order_acquire) >= (unsigned int)INPUT_QUEUE_CAPACITY) {
+        std::cout << "Input queue full, key dropped" << std::endl;
+        return;
+    }
+    inputQueue[tail & (INPUT_QUEUE_CAPACITY - 1)].type = type;
+    inputQueue[tail & (INPUT_QUEUE_CAPACITY - 1)].key = key;
+    inputTail.store(tail + 1, std::memory_order_release);
+}
+
+static void drainInputEvents() {
+    unsigned int head = inputHead.load(std::memory_order_relaxed);
+    unsigned int tail = inputTail.load(std::memory_order_acquire);
+    while (head != tail) {
+        InputEvent event = inputQueue[head & (INPUT_QUEUE_CAPACITY - 1)];
+        head++;
+        inputHead.store(head, std::memory_order_release);
+
+        switch (event.type) {
+            case INPUT_KEY_DOWN:    handleKeyDown((unsigned char)event.key); break;
+            case INPUT_KEY_UP:      handleKeyUp((unsigned char)event.key); break;
+            case INPUT_SPECIAL_KEY: handleSpecialKey(event.key); break;
+        }
+    }
+}
+
+// ========== DELAYED CALLBACKS ==========
+struct SimulationCallback {
+    void (*callback)(int);
+    int value;
+    int framesLeft;
+};
+
+static SimulationCallback pendingCallbacks[SIMULATION_MAX_CALLBACKS];
+static int pendingCallbackCount = 0;
+
+void scheduleSimulationCallback(int delayMs, void (*callback)(int), int value) {
+    if (pendingCallbackCount == SIMULATION_MAX_CALLBACKS) {
+        std::cout << "Too many pending simulation callbacks" << std::endl;
+        return;
+    }
+    SimulationCallback& pending = pendingCallbacks[pendingCallbackCount++];
+    pending.callback = callback;
+    pending.value = value;
+    pending.framesLeft = delayMs / SIMULATION_FRAME_MS;
+}
+
+static void cancelSimulationCallbacks() {
+    pendingCallbackCount = 0;
+}
+
+static void runDueCallbacks() {
+    int i = 0;
+    while (i < pendingCallbackCount) {
+        if (pendingCallbacks[i].framesLeft-- > 0) {
+            i++;
+            continue;
+        }
+        SimulationCallback due = pendingCallbacks[i];
+        pendingCallbacks[i] = pendingCallbacks[--pendingCallbackCount];
+        due.callback(due.value);
+    }
+}
+
+// ========== CHECKPOINTS ==========
+static SimulationSnapshot launchState;       // State right after setup, for resets
+static SimulationSnapshot checkpointScratch; // Simulation thread only
+static std::string resumeCheckpointPath;
+
+bool saveSimulationCheckpoint(const char* path) {
+    captureSimulationSnapshot(checkpointScratch);
+    return saveCheckpoint(path, checkpointScratch);
+}
+
+bool loadSimulationCheckpoint(const char* path) {
+    if (!loadCheckpoint(path, checkpointScratch)) return false;
+    applySimulationSnapshot(checkpointScratch);
+    cancelSimulationCallbacks();
+    return true;
+}
+
+void resetSimulation() {
+    bool keepStats = showStats;
+    bool keepGrid = showGrid;
+    bool keepDayNightCycle = dayNightCycle;
+    IntegratorType keepIntegrator = currentIntegrator;
+
+    applySimulationSnapshot(launchState);
+    cancelSimulationCallbacks();
+
+    showStats = keepStats;
+    showGrid = keepGrid;
+    dayNightCycle = keepDayNightCycle;
+    currentIntegrator = keepIntegrator;
+}
+
+void resumeFromCheckpoint(const char* path) {
+    resumeCheckpointPath = path;
+}
+
+// ========== THREAD ==========
+static std::thread simulationThread;
+static std::atomic<bool> simulationRunning(false);
+
+static void simulationLoop() {
+    simulationRandomCounter = (unsigned long long)rand() << 32;
+    applyScenario(scenario);
+    initializeClouds();
+    initializeSatellites();
+    initializeMeteors();
+    if (!resumeCheckpointPath.empty() && loadSimulationCheckpoint(resumeCheckpointPath.c_str())) {
+        std::cout << "Resumed from checkpoint " << resumeCheckpointPath << std::endl;
+    }
+    captureSimulationSnapshot(launchState);
+    publishSnapshot();
+    startJobSystem(defaultJobWorkerCount());
+
+    std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+    while (simulationRunning.load(std::memory_order_acquire)) {
+        drainInputEvents();
+        runDueCallbacks();
+        simulationFrame();
+        publishSnapshot();
+
+        // Fixed frame rate; after a long stall, resume instead of catching up
+        next += std::chrono::milliseconds(SIMULATION_FRAME_MS);
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now - next > std::chrono::milliseconds(SIMULATION_MAX_LAG_MS)) {
+            next = now;
+        }
+        std::this_thread::sleep_until(next);
+    }
+    stopJobSystem();
+}
+
+void startSimulationThread() {
+    if (simulationRunning.load()) return;
+
+    static bool exitHandlerInstalled = false;
+    if (!exitHandlerInstalled) {
+        // The thread must be joined before static destruction
+        std::atexit(stopSimulationThread);
+        exitHandlerInstalled = true;
+    }
+
+    // Until the first frame is published the renderer shows the state
+    // as it is now, before the simulation thread takes the globals over
+    for (int i = 0; i < 3; i++) {
+        captureSimulationSnapshot(snapshotSlots[i]);
+    }
+    simulationRunning.store(true);
+    simulationThread = std::thread(simulationLoop);
+}
+
+void stopSimulationThread() {
+    if (!simulationRunning.exchange(false)) return;
+    simulationThread.join();
+}
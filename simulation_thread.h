@@ -0,0 +1,50 @@
+// simulation_thread.h
+#ifndef SIMULATION_THREAD_H
+#define SIMULATION_THREAD_H
+
+// ================== SIMULATION THREAD ==================
+// The simulation runs on its own thread at a fixed 16 ms frame and
+// publishes a SimulationSnapshot after every frame through a lock-free
+// triple buffer: it never waits for the renderer, and the renderer always
+// picks up the newest complete frame. Input crosses the other way through
+// a single-producer/single-consumer queue drained at the top of each frame.
+//
+// GLUT is not thread-safe, so nothing reached from the simulation loop
+// calls it: timers go through scheduleSimulationCallback and animation
+// time comes from simulationSeconds(), never GLUT_ELAPSED_TIME.
+enum InputEventType {
+    INPUT_KEY_DOWN,
+    INPUT_KEY_UP,
+    INPUT_SPECIAL_KEY
+};
+
+// GLUT thread: queue an input event (dropped with a message if full)
+void postInputEvent(InputEventType type, int key);
+
+// Start from a saved checkpoint instead of the scenario (call before
+// startSimulationThread; falls back to the scenario if it cannot be read)
+void resumeFromCheckpoint(const char* path);
+
+void startSimulationThread();
+void stopSimulationThread(); // Safe to call more than once
+
+struct SimulationSnapshot;
+
+// GLUT thread: the newest published snapshot, unchanged until the next
+// call. 'fresh' is set if it was published since the previous call.
+const SimulationSnapshot& latestSnapshot(bool& fresh);
+
+// Simulation thread: run 'callback(value)' after 'delayMs' of simulation
+// frames (replaces glutTimerFunc for state owned by the simulation)
+void scheduleSimulationCallback(int delayMs, void (*callback)(int), int value);
+
+// Simulation thread: checkpoint the whole simulation state to 'path', or
+// replace it with one. Pending callbacks are dropped on load.
+bool saveSimulationCheckpoint(const char* path);
+bool loadSimulationCheckpoint(const char* path);
+
+// Simulation thread: back to the state the run started from, keeping the
+// display toggles and integrator choice
+void resetSimulation();
+
+#endif
@@ -0,0 +1,166 @@
+#include "span_tables.h"
+#include "constants_config.h"
+#include <vector>
+
+// ========== TABLE GENERATION ==========
+// Both walks visit every row at least once; a row keeps its widest point
+static void widenRow(int* halfWidth, long long row, long long x) {
+    if (x > halfWidth[row]) halfWidth[row] = (int)x;
+}
+
+// Midpoint circle: each step gives row y (half-width x) and, by symmetry
+// about the diagonal, row x (half-width y)
+static void buildCircleSpans(int radius, int* halfWidth) {
+    for (int row = 0; row <= radius; row++) halfWidth[row] = 0;
+
+    int x = 0;
+    int y = radius;
+    int d = 1 - radius;
+    while (true) {
+        widenRow(halfWidth, y, x);
+        widenRow(halfWidth, x, y);
+        if (x >= y) break;
+        x++;
+        if (d < 0) {
+            d += 2 * x + 1;
+        } else {
+            y--;
+            d += 2 * (x - y) + 1;
+        }
+    }
+}
+
+// Midpoint ellipse with the decision values scaled by 4, so the half-pixel
+// offsets of the textbook form stay integral
+static void buildEllipseSpans(int rx, int ry, int* halfWidth) {
+    for (int row = 0; row <= ry; row++) halfWidth[row] = 0;
+    if (ry == 0) {
+        halfWidth[0] = rx;
+        return;
+    }
+
+    long long rx2 = (long long)rx * rx;
+    long long ry2 = (long long)ry * ry;
+    long long x = 0;
+    long long y = ry;
+    long long dx = 0;
+    long long dy = 2 * rx2 * y;
+
+    // Region 1: slope above -1, x advances every step
+    long long d1 = 4 * ry2 - 4 * rx2 * ry + rx2;
+    while (dx < dy) {
+        widenRow(halfWidth, y, x);
+        x++;
+        dx += 2 * ry2;
+        if (d1 < 0) {
+            d1 += 4 * (dx + ry2);
+        } else {
+            y--;
+            dy -= 2 * rx2;
+            d1 += 4 * (dx - dy + ry2);
+        }
+    }
+
+    // Region 2: slope below -1, y advances every step
+    long long d2 = ry2 * (2 * x + 1) * (2 * x + 1) + 4 * rx2 * (y - 1) * (y - 1) - 4 * rx2 * ry2;
+    while (y >= 0) {
+        widenRow(halfWidth, y, x);
+        y--;
+        dy -= 2 * rx2;
+        if (d2 > 0) {
+            d2 += 4 * (rx2 - dy);
+        } else {
+            x++;
+            dx += 2 * ry2;
+            d2 += 4 * (dx - dy + rx2);
+        }
+    }
+}
+
+// ========== CACHE ==========
+enum SpanShape { SPAN_CIRCLE, SPAN_ELLIPSE };
+
+struct SpanCacheSlot {
+    int rx, ry;    // rx < 0: empty slot
+    int shape;
+    int offset;    // First row in SpanTableCache::rows
+};
+
+struct SpanTableCache {
+    std::vector<SpanCacheSlot> slots;
+    std::vector<int> rows;     // Reserved once, so tables never move
+    std::vector<int> oversize; // Tables too large to cache
+    int usedSlots;
+
+    SpanTableCache() : usedSlots(0) {}
+};
+
+static thread_local SpanTableCache spanCache;
+
+static void clearSpanCache(SpanTableCache& cache) {
+    if (cache.slots.empty()) {
+        cache.slots.resize(SPAN_CACHE_SLOTS);
+        cache.rows.reserve(SPAN_CACHE_ROWS);
+    }
+    for (int i = 0; i < SPAN_CACHE_SLOTS; i++) {
+        cache.slots[i].rx = -1;
+    }
+    cache.rows.clear();
+    cache.usedSlots = 0;
+}
+
+static unsigned int spanSlotHash(int shape, int rx, int ry) {
+    unsigned int h = (unsigned int)rx * 73856093U ^ (unsigned int)ry * 19349663U ^ (unsigned int)shape * 83492791U;
+    return h ^ (h >> 13);
+}
+
+static void buildSpans(int shape, int rx, int ry, int* halfWidth) {
+    if (shape == SPAN_CIRCLE) buildCircleSpans(rx, halfWidth);
+    else buildEllipseSpans(rx, ry, halfWidth);
+}
+
+static const int* lookupSpanTable(int shape, int rx, int ry) {
+    SpanTableCache& cache = spanCache;
+    if (cache.slots.empty()) clearSpanCache(cache);
+
+    int rowCount = ry + 1;
+    if (rowCount > SPAN_CACHE_ROWS) {
+        cache.oversize.resize(rowCount);
+        buildSpans(shape, rx, ry, &cache.oversize[0]);
+        return &cache.oversize[0];
+    }
+
+    const unsigned int mask = SPAN_CACHE_SLOTS - 1;
+    unsigned int slot = spanSlotHash(shape, rx, ry) & mask;
+    for (; cache.slots[slot].rx >= 0; slot = (slot + 1) & mask) {
+        const SpanCacheSlot& entry = cache.slots[slot];
+        if (entry.rx == rx && entry.ry == ry && entry.shape == shape) {
+            return &cache.rows[entry.offset];
+        }
+    }
+
+    // Keep the probe table at most 3/4 full and the rows within capacity
+    if (cache.usedSlots >= SPAN_CACHE_SLOTS * 3 / 4 ||
+        (int)cache.rows.size() + rowCount > SPAN_CACHE_ROWS) {
+        clearSpanCache(cache);
+        slot = spanSlotHash(shape, rx, ry) & mask;
+    }
+
+    SpanCacheSlot& entry = cache.slots[slot];
+    entry.rx = rx;
+    entry.ry = ry;
+    entry.shape = shape;
+    entry.offset = (int)cache.rows.size();
+    cache.usedSlots++;
+    cache.rows.resize(cache.rows.size() + rowCount);
+    buildSpans(shape, rx, ry, &cache.rows[entry.offset]);
+    return &cache.rows[entry.offset];
+}
+
+const int* circleSpanTable(int radius) {
+    return lookupSpanTable(SPAN_CIRCLE, radius, radius);
+}
+
+const int* ellipseSpanTable(int rx, int ry) {
+    return lookupSpanTable(SPAN_ELLIPSE, rx, ry);
+}
@@ -0,0 +1,18 @@
+// span_tables.h
+#ifndef SPAN_TABLES_H
+#define SPAN_TABLES_H
+
+// ================== FILLED SHAPE SPAN TABLES ==================
+// A filled circle or ellipse is drawn as one horizontal span per row. Its
+// span table holds the half-width of each row from the center row (0) to
+// the top row (radius / ry), found once with the integer midpoint
+// algorithm; the lower half mirrors the upper one.
+//
+// Tables are cached per radius and per (rx, ry) and reused across frames.
+// When the cache fills up it is emptied and refilled on demand. Each
+// thread has its own cache. A returned table stays valid until the next
+// call on the same thread.
+const int* circleSpanTable(int radius);          // radius + 1 rows
+const int* ellipseSpanTable(int rx, int ry);     // ry + 1 rows
+
+#endif
@@ -0,0 +1,201 @@
+#include "starfield.h"
+#include "simd_lanes.h"
+#include <cmath>
+
+#ifdef __APPLE__
+#include <GLUT/glut.h>
+#else
+#include <GL/glut.h>
+#endif
+
+// ========== HASHING ==========
+static unsigned int mixBits(unsigned int x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+static unsigned int tileHash(unsigned int seed, int tileX, int tileY) {
+    return mixBits(seed ^ mixBits((unsigned int)tileX * 0x9E3779B9U ^ mixBits((unsigned int)tileY)));
+}
+
+// Uniform value in [0, 1) from the top 24 bits
+static float unitFloat(unsigned int bits) {
+    return (bits >> 8) * (1.0f / 16777216.0f);
+}
+
+// Star 'index' of a tile: position inside the tile and twinkle speed
+static void generateStar(unsigned int hash, int tileX, int tileY, int index,
+                         float& x, float& y, float& twinkleSpeed) {
+    unsigned int state = mixBits(hash + (unsigned int)index * 0x9E3779B9U);
+    x = (tileX + unitFloat(state)) * STARFIELD_TILE_SIZE;
+    state = mixBits(state);
+    y = STARFIELD_MIN_Y + (tileY + unitFloat(state)) * STARFIELD_TILE_SIZE;
+    state = mixBits(state);
+    twinkleSpeed = 0.1f + 0.9f * unitFloat(state);
+}
+
+static void generateTile(StarTile& tile, unsigned int seed, int count) {
+    unsigned int hash = tileHash(seed, tile.tileX, tile.tileY);
+    for (int i = 0; i < count; i++) {
+        generateStar(hash, tile.tileX, tile.tileY, i, tile.x[i], tile.y[i], tile.twinkleSpeed[i]);
+    }
+}
+
+// ========== LRU TILE CACHE ==========
+void initializeStarfield(Starfield& field, unsigned int seed) {
+    field.seed = seed;
+    field.time = 0.0f;
+    field.usedTiles = 0;
+    field.newest = -1;
+    field.oldest = -1;
+    for (int i = 0; i < STARFIELD_HASH_BUCKETS; i++) {
+        field.buckets[i] = -1;
+    }
+}
+
+static int bucketOf(int tileX, int tileY) {
+    return (int)(mixBits((unsigned int)tileX * 73856093U ^ (unsigned int)tileY * 19349663U) &
+                 (STARFIELD_HASH_BUCKETS - 1));
+}
+
+static void unlinkRecent(Starfield& field, int slot) {
+    StarTile& tile = field.tiles[slot];
+    if (tile.newer >= 0) field.tiles[tile.newer].older = tile.older;
+    else field.newest = tile.older;
+    if (tile.older >= 0) field.tiles[tile.older].newer = tile.newer;
+    else field.oldest = tile.newer;
+}
+
+static void linkNewest(Starfield& field, int slot) {
+    StarTile& tile = field.tiles[slot];
+    tile.newer = -1;
+    tile.older = field.newest;
+    if (field.newest >= 0) field.tiles[field.newest].newer = slot;
+    field.newest = slot;
+    if (field.oldest < 0) field.oldest = slot;
+}
+
+static void unlinkBucket(Starfield& field, int slot) {
+    StarTile& tile = field.tiles[slot];
+    int* link = &field.buckets[bucketOf(tile.tileX, tile.tileY)];
+    while (*link >= 0) {
+        if (*link == slot) {
+            *link = tile.bucketNext;
+            return;
+        }
+        link = &field.tiles[*link].bucketNext;
+    }
+}
+
+// Cached tile, generating it (and evicting the least recently used) if needed
+static StarTile& acquireTile(Starfield& field, int tileX, int tileY) {
+    int bucket = bucketOf(tileX, tileY);
+    for (int slot = field.buckets[bucket]; slot >= 0; slot = field.tiles[slot].bucketNext) {
+        StarTile& tile = field.tiles[slot];
+        if (tile.tileX == tileX && tile.tileY == tileY) {
+            if (field.newest != slot) {
+                unlinkRecent(field, slot);
+                linkNewest(field, slot);
+            }
+            return tile;
+        }
+    }
+
+    int slot;
+    if (field.usedTiles < STARFIELD_CACHE_TILES) {
+        slot = field.usedTiles++;
+    } else {
+        slot = field.oldest;
+        unlinkRecent(field, slot);
+        unlinkBucket(field, slot);
+    }
+
+    StarTile& tile = field.tiles[slot];
+    tile.tileX = tileX;
+    tile.tileY = tileY;
+    generateTile(tile, field.seed, STARFIELD_STARS_PER_TILE);
+    tile.bucketNext = field.buckets[bucket];
+    field.buckets[bucket] = slot;
+    linkNewest(field, slot);
+    return tile;
+}
+
+// ========== DRAWING ==========
+// brightness = (0.5 + 0.5 * |sin(time * speed)|) * dayFactor, four stars at
+// a time. |sin| uses Bhaskara's rational approximation on the half period.
+static void twinkleBrightness(const float* twinkleSpeed, float* brightness, int count,
+                              float time, float dayFactor) {
+    Lanes t = splat(time);
+    Lanes inversePi = splat(1.0f / 3.14159265f);
+    Lanes one = splat(1.0f);
+    Lanes half = splat(0.5f);
+    Lanes scale = splat(dayFactor);
+
+    for (int i = 0; i < count; i += 4) {
+        Lanes turns = mul(mul(t, loadLanes(twinkleSpeed + i)), inversePi);
+        Lanes f = sub(turns, truncateLanes(turns));
+        Lanes p = mul(f, sub(one, f));
+        Lanes s = divide(mul(splat(16.0f), p), sub(splat(5.0f), mul(splat(4.0f), p)));
+        storeLanes(brightness + i, mul(add(half, mul(half, s)), scale));
+    }
+}
+
+static void emitStars(const float* x, const float* y, const float* brightness, int count) {
+    for (int i = 0; i < count; i++) {
+        float b = brightness[i];
+        if (b < STARFIELD_MIN_BRIGHTNESS) continue;
+        glColor3f(b, b, b);
+        glVertex2f(x[i], y[i]);
+    }
+}
+
+void drawStarfield(Starfield& field, float left, float bottom, float right, float top,
+                   float pixelScale, float dayFactor) {
+    if (dayFactor <= 0.0f || top < STARFIELD_MIN_Y) return;
+
+    // Keep roughly the same number of stars per screen pixel at any zoom
+    float drawFraction = pixelScale * pixelScale;
+    if (drawFraction > 1.0f) drawFraction = 1.0f;
+
+    int firstX = (int)std::floor(left / STARFIELD_TILE_SIZE);
+    int lastX = (int)std::floor(right / STARFIELD_TILE_SIZE);
+    int firstY = (int)std::floor((bottom - STARFIELD_MIN_Y) / STARFIELD_TILE_SIZE);
+    int lastY = (int)std::floor((top - STARFIELD_MIN_Y) / STARFIELD_TILE_SIZE);
+    if (firstY < 0) firstY = 0;
+
+    float x[STARFIELD_STARS_PER_TILE];
+    float y[STARFIELD_STARS_PER_TILE];
+    float speed[STARFIELD_STARS_PER_TILE];
+    float brightness[STARFIELD_STARS_PER_TILE];
+
+    glPointSize(2.0f);
+    glBegin(GL_POINTS);
+    for (int tileY = firstY; tileY <= lastY; tileY++) {
+        for (int tileX = firstX; tileX <= lastX; tileX++) {
+            // Stable per-tile rounding so stars only appear/disappear with zoom
+            unsigned int hash = tileHash(field.seed, tileX, tileY);
+            int count = (int)(STARFIELD_STARS_PER_TILE * drawFraction + unitFloat(mixBits(hash ^ 0xA5A5A5A5U)));
+            if (count <= 0) continue;
+            if (count > STARFIELD_STARS_PER_TILE) count = STARFIELD_STARS_PER_TILE;
+            int padded = (count + 3) & ~3;
+
+            if (drawFraction < STARFIELD_CACHE_MIN_FRACTION) {
+                // Only a few stars per tile: cheaper to generate them than to cache
+                for (int i = 0; i < padded; i++) {
+                    generateStar(hash, tileX, tileY, i, x[i], y[i], speed[i]);
+                }
+                twinkleBrightness(speed, brightness, padded, field.time, dayFactor);
+                emitStars(x, y, brightness, count);
+            } else {
+                StarTile& tile = acquireTile(field, tileX, tileY);
+                twinkleBrightness(tile.twinkleSpeed, brightness, padded, field.time, dayFactor);
+                emitStars(tile.x, tile.y, brightness, count);
+            }
+        }
+    }
+    glEnd();
+}
@@ -0,0 +1,39 @@
+// starfield.h
+#ifndef STARFIELD_H
+#define STARFIELD_H
+
+#include "constants_config.h"
+
+// ================== PROCEDURAL STARFIELD ==================
+// The sky above STARFIELD_MIN_Y is cut into square world tiles. A tile's
+// stars are a pure function of (seed, tile, star index), so any tile can be
+// regenerated at any time and the field has no edge. Recently drawn tiles
+// are kept in a small LRU cache; drawing costs only what is on screen.
+struct StarTile {
+    int tileX, tileY;
+    float x[STARFIELD_STARS_PER_TILE];
+    float y[STARFIELD_STARS_PER_TILE];
+    float twinkleSpeed[STARFIELD_STARS_PER_TILE];
+    int newer, older;  // LRU list links (slot indices, -1 at the ends)
+    int bucketNext;    // Next slot in the same hash bucket
+};
+
+struct Starfield {
+    unsigned int seed;
+    float time;        // Twinkle clock in seconds
+    int usedTiles;
+    int newest, oldest;
+    int buckets[STARFIELD_HASH_BUCKETS];
+    StarTile tiles[STARFIELD_CACHE_TILES];
+};
+
+void initializeStarfield(Starfield& field, unsigned int seed);
+
+// Draw the stars inside the world rectangle. 'pixelScale' is the world to
+// pixel scale (fewer stars per tile are drawn when zoomed out, keeping the
+// on-screen density) and 'dayFactor' scales brightness; nothing is drawn
+// once it reaches zero.
+void drawStarfield(Starfield& field, float left, float bottom, float right, float top,
+                   float pixelScale, float dayFactor);
+
+#endif
@@ -0,0 +1,105 @@
+#include "terrain.h"
+#include <cmath>
+
+#ifdef __APPLE__
+#include <GLUT/glut.h>
+#else
+#include <GL/glut.h>
+#endif
+
+static const float TERRAIN_CHUNK_WIDTH = TERRAIN_CHUNK_SAMPLES * TERRAIN_SAMPLE_SPACING;
+
+// ========== HEIGHT PROFILE ==========
+// Rolling hills (the profile the original ground polygon was drawn from)
+static float terrainProfile(float x) {
+    return 120 + 30 * std::sin(x * 0.02f) + 20 * std::sin(x * 0.05f);
+}
+
+static float sampleX(int chunkIndex, int sample) {
+    return (float)(chunkIndex * TERRAIN_CHUNK_SAMPLES + sample) * TERRAIN_SAMPLE_SPACING;
+}
+
+static int chunkOf(float x) {
+    return (int)std::floor(x / TERRAIN_CHUNK_WIDTH);
+}
+
+static int slotOf(int chunkIndex) {
+    int slot = chunkIndex % TERRAIN_RESIDENT_CHUNKS;
+    return slot < 0 ? slot + TERRAIN_RESIDENT_CHUNKS : slot;
+}
+
+// ========== CHUNK STREAMING ==========
+void initializeTerrain(Terrain& terrain) {
+    for (int i = 0; i < TERRAIN_RESIDENT_CHUNKS; i++) {
+        terrain.chunks[i].loaded = false;
+    }
+    terrain.chunkLoads = 0;
+}
+
+static TerrainChunk& loadChunk(Terrain& terrain, int chunkIndex) {
+    TerrainChunk& chunk = terrain.chunks[slotOf(chunkIndex)];
+    if (chunk.loaded && chunk.index == chunkIndex) return chunk;
+
+    chunk.index = chunkIndex;
+    for (int i = 0; i <= TERRAIN_CHUNK_SAMPLES; i++) {
+        chunk.height[i] = terrainProfile(sampleX(chunkIndex, i));
+    }
+    chunk.loaded = true;
+    terrain.chunkLoads++;
+    return chunk;
+}
+
+void streamTerrain(Terrain& terrain, float left, float right) {
+    int first = chunkOf(left) - 1;
+    int last = chunkOf(right) + 1;
+    // A view wider than the table only keeps the chunks around its centre
+    if (last - first >= TERRAIN_RESIDENT_CHUNKS) {
+        int centre = (first + last) / 2;
+        first = centre - TERRAIN_RESIDENT_CHUNKS / 2;
+        last = first + TERRAIN_RESIDENT_CHUNKS - 1;
+    }
+    for (int c = first; c <= last; c++) {
+        loadChunk(terrain, c);
+    }
+}
+
+// ========== QUERIES ==========
+float terrainHeight(const Terrain& terrain, float x) {
+    int chunkIndex = chunkOf(x);
+    float local = (x - chunkIndex * TERRAIN_CHUNK_WIDTH) / TERRAIN_SAMPLE_SPACING;
+    int sample = (int)local;
+    if (sample >= TERRAIN_CHUNK_SAMPLES) sample = TERRAIN_CHUNK_SAMPLES - 1;
+    float t = local - sample;
+
+    const TerrainChunk& chunk = terrain.chunks[slotOf(chunkIndex)];
+    float h0, h1;
+    if (chunk.loaded && chunk.index == chunkIndex) {
+        h0 = chunk.height[sample];
+        h1 = chunk.height[sample + 1];
+    } else {
+        h0 = terrainProfile(sampleX(chunkIndex, sample));
+        h1 = terrainProfile(sampleX(chunkIndex, sample + 1));
+    }
+    return h0 + (h1 - h0) * t;
+}
+
+// ========== DRAWING ==========
+void drawTerrain(Terrain& terrain, float left, float right, float bottom) {
+    streamTerrain(terrain, left, right);
+
+    int first = chunkOf(left);
+    int last = chunkOf(right);
+    for (int c = first; c <= last; c++) {
+        const TerrainChunk& chunk = terrain.chunks[slotOf(c)];
+        bool resident = chunk.loaded && chunk.index == c;
+
+        glBegin(GL_QUAD_STRIP);
+        for (int i = 0; i <= TERRAIN_CHUNK_SAMPLES; i++) {
+            float x = sampleX(c, i);
+            float height = resident ? chunk.height[i] : terrainProfile(x);
+            glVertex2f(x, bottom);
+            glVertex2f(x, height);
+        }
+        glEnd();
+    }
+}
@@ -0,0 +1,38 @@
+// terrain.h
+#ifndef TERRAIN_H
+#define TERRAIN_H
+
+#include "constants_config.h"
+
+// ================== TERRAIN HEIGHTFIELD ==================
+// The ground profile is sampled every TERRAIN_SAMPLE_SPACING world units and
+// grouped into chunks of TERRAIN_CHUNK_SAMPLES samples (chunk 0 starts at
+// x = 0, negative chunks extend to the left). Resident chunks live in a
+// direct-mapped table keyed on the chunk index; panning the camera streams
+// new chunks in and overwrites the ones that fell out of view.
+struct TerrainChunk {
+    int index;      // Chunk number along x
+    bool loaded;
+    float height[TERRAIN_CHUNK_SAMPLES + 1]; // Last sample is shared with the next chunk
+};
+
+struct Terrain {
+    TerrainChunk chunks[TERRAIN_RESIDENT_CHUNKS];
+    int chunkLoads; // Chunks generated so far
+};
+
+void initializeTerrain(Terrain& terrain);
+
+// Make every chunk overlapping [left, right] (plus one chunk of margin on
+// each side) resident
+void streamTerrain(Terrain& terrain, float left, float right);
+
+// Ground height at 'x', linearly interpolated between samples. Works for
+// any x: chunks that are not resident are evaluated on the fly with the
+// same samples, so collisions agree with what is drawn.
+float terrainHeight(const Terrain& terrain, float x);
+
+// Filled ground between 'bottom' and the surface over [left, right]
+void drawTerrain(Terrain& terrain, float left, float right, float bottom);
+
+#endif
@@ -0,0 +1,158 @@
+// rasterizer_aa_test.cpp
+// The anti-aliased rasterizers of rasterizer_aa.h drawn white into a
+// FramebufferSink and compared, pixel by pixel, with the coverage of the
+// same shape supersampled 16x16 per pixel. Shapes reach past the buffer
+// edges so the clipped paths are covered too.
+#include "framebuffer.h"
+#include "rasterizer_aa.h"
+#include "raster_sinks.h"
+#include <cmath>
+#include <cstdio>
+
+static const int TEST_WIDTH = 400;
+static const int TEST_HEIGHT = 300;
+static const int SUPERSAMPLES = 16;         // Per axis
+static const double MAX_MEAN_ERROR = 0.005; // Over the pixels either side touches
+static const double MAX_PIXEL_ERROR = 0.15; // Curves are estimated from one distance per pixel
+
+static int failures = 0;
+
+static double coverageAt(const Framebuffer& framebuffer, int x, int y) {
+    return (framebuffer.pixels[(size_t)y * framebuffer.width + x] & 255) / 255.0;
+}
+
+static void check(bool passed, const char* name, const char* detail) {
+    printf("  %-5s %-16s %s\n", passed ? "ok" : "FAIL", name, detail);
+    if (!passed) failures++;
+}
+
+// Pixel (x, y) is the unit square centered on (x, y)
+template <typename Inside>
+static void checkAgainstReference(const char* name, const Framebuffer& framebuffer, Inside inside) {
+    double sum = 0.0;
+    double worst = 0.0;
+    int touched = 0;
+    for (int y = 0; y < TEST_HEIGHT; y++) {
+        for (int x = 0; x < TEST_WIDTH; x++) {
+            int hits = 0;
+            for (int j = 0; j < SUPERSAMPLES; j++) {
+                for (int i = 0; i < SUPERSAMPLES; i++) {
+                    hits += inside(x - 0.5 + (i + 0.5) / SUPERSAMPLES, y - 0.5 + (j + 0.5) / SUPERSAMPLES);
+                }
+            }
+            double reference = hits / (double)(SUPERSAMPLES * SUPERSAMPLES);
+            double drawn = coverageAt(framebuffer, x, y);
+            if (reference > 0.0 || drawn > 0.0) {
+                sum += std::fabs(reference - drawn);
+                touched++;
+            }
+            worst = std::max(worst, std::fabs(reference - drawn));
+        }
+    }
+    double mean = touched ? sum / touched : 0.0;
+    char detail[96];
+    snprintf(detail, sizeof(detail), "mean error %.4f, worst pixel %.4f", mean, worst);
+    check(touched > 0 && mean < MAX_MEAN_ERROR && worst < MAX_PIXEL_ERROR, name, detail);
+}
+
+static bool insidePolygon(const std::pair<float, float>* vertices, int count, double x, double y) {
+    bool inside = false;
+    for (int i = 0, j = count - 1; i < count; j = i++) {
+        const std::pair<float, float>& a = vertices[i];
+        const std::pair<float, float>& b = vertices[j];
+        if ((a.second > y) != (b.second > y) &&
+            x < (b.first - a.first) * (y - a.second) / (b.second - a.second) + a.first) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+static double totalCoverage(const Framebuffer& framebuffer) {
+    double total = 0.0;
+    for (size_t i = 0; i < framebuffer.pixels.size(); i++) total += (framebuffer.pixels[i] & 255) / 255.0;
+    return total;
+}
+
+int main() {
+    Framebuffer framebuffer;
+    const unsigned int white = 0xFFFFFFFFu;
+    printf("Anti-aliased rasterizers against a %dx%d supersampled reference\n", SUPERSAMPLES, SUPERSAMPLES);
+
+    resizeFramebuffer(framebuffer, TEST_WIDTH, TEST_HEIGHT);
+    {
+        FramebufferSink sink(framebuffer, white);
+        rasterFilledCircleAA(sink, 200.3f, 150.7f, 100.2f);
+    }
+    checkAgainstReference("filled circle", framebuffer, [](double x, double y) {
+        return (x - 200.3) * (x - 200.3) + (y - 150.7) * (y - 150.7) < 100.2 * 100.2;
+    });
+
+    resizeFramebuffer(framebuffer, TEST_WIDTH, TEST_HEIGHT);
+    {
+        FramebufferSink sink(framebuffer, white);
+        rasterFilledEllipseAA(sink, 180.5f, 140.2f, 250.0f, 60.0f);
+    }
+    checkAgainstReference("filled ellipse", framebuffer, [](double x, double y) {
+        double u = (x - 180.5) / 250.0;
+        double v = (y - 140.2) / 60.0;
+        return u * u + v * v < 1.0;
+    });
+
+    const std::pair<float, float> polygon[5] = {
+        {-50.0f, 40.0f}, {210.3f, -30.0f}, {420.0f, 180.5f}, {150.2f, 320.0f}, {80.7f, 120.1f}};
+    resizeFramebuffer(framebuffer, TEST_WIDTH, TEST_HEIGHT);
+    {
+        FramebufferSink sink(framebuffer, white);
+        rasterFilledPolygonAA(sink, polygon, 5);
+    }
+    checkAgainstReference("concave polygon", framebuffer, [&](double x, double y) {
+        return insidePolygon(polygon, 5, x, y);
+    });
+
+    const std::pair<float, float> triangle[3] = {{12.25f, 280.5f}, {390.75f, 8.0f}, {300.5f, 295.25f}};
+    resizeFramebuffer(framebuffer, TEST_WIDTH, TEST_HEIGHT);
+    {
+        FramebufferSink sink(framebuffer, white);
+        rasterFilledTriangleAA(sink, triangle[0].first, triangle[0].second, triangle[1].first,
+                               triangle[1].second, triangle[2].first, triangle[2].second);
+    }
+    checkAgainstReference("thin triangle", framebuffer, [&](double x, double y) {
+        return insidePolygon(triangle, 3, x, y);
+    });
+
+    // A one pixel wide ring covers 2 pi r in total
+    resizeFramebuffer(framebuffer, TEST_WIDTH, TEST_HEIGHT);
+    {
+        FramebufferSink sink(framebuffer, white);
+        rasterCircleAA(sink, 200.0f, 150.0f, 80.0f);
+    }
+    {
+        double expected = 2.0 * M_PI * 80.0;
+        double total = totalCoverage(framebuffer);
+        char detail[96];
+        snprintf(detail, sizeof(detail), "coverage %.1f, 2 pi r %.1f", total, expected);
+        check(std::fabs(total - expected) < 0.01 * expected, "circle outline", detail);
+    }
+
+    // Each column of a Wu line shares one pixel of coverage between two rows
+    resizeFramebuffer(framebuffer, TEST_WIDTH, TEST_HEIGHT);
+    {
+        FramebufferSink sink(framebuffer, white);
+        rasterLineWu(sink, -20.0f, 10.0f, 500.0f, 200.0f);
+    }
+    {
+        double worst = 0.0;
+        for (int x = 0; x < TEST_WIDTH; x++) {
+            double column = 0.0;
+            for (int y = 0; y < TEST_HEIGHT; y++) column += coverageAt(framebuffer, x, y);
+            worst = std::max(worst, std::fabs(column - 1.0));
+        }
+        char detail[96];
+        snprintf(detail, sizeof(detail), "worst column off by %.4f", worst);
+        check(worst < 0.02, "Wu line", detail);
+    }
+
+    printf("%s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
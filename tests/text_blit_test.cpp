@@ -0,0 +1,75 @@
+// text_blit_test.cpp
+// blitTextRun drawn into a Framebuffer and compared, pixel by pixel, with
+// the font bitmaps it comes from: opaque, blended over a background, and
+// placed across every edge of the buffer so the clipped rows and columns
+// are covered too.
+#include "blend_spans.h"
+#include "font_9x15.h"
+#include "framebuffer.h"
+#include "text_renderer.h"
+#include <cstdio>
+
+static const int TEST_WIDTH = 120;
+static const int TEST_HEIGHT = 40;
+static const unsigned int BACKGROUND = 0xFF403020u;
+
+static int failures = 0;
+
+static void check(bool passed, const char* name, const char* detail) {
+    printf("  %-5s %-16s %s\n", passed ? "ok" : "FAIL", name, detail);
+    if (!passed) failures++;
+}
+
+// Whether the glyphs of 'text' at baseline origin (x, y) cover pixel (px, py)
+static bool fontCovers(const char* text, int x, int y, int px, int py) {
+    int row = py - (y - FONT_9X15_BASELINE);
+    if (row < 0 || row >= FONT_9X15_HEIGHT) return false;
+    for (int i = 0; text[i]; i++) {
+        int col = px - (x + i * FONT_9X15_WIDTH);
+        if (col < 0 || col >= FONT_9X15_WIDTH) continue;
+        int cell = (unsigned char)text[i] - FONT_9X15_FIRST_CHAR;
+        if (cell <= 0 || cell >= FONT_9X15_CHAR_COUNT) return false;
+        return (FONT_9X15_ROWS[cell][row] & (0x8000 >> col)) != 0;
+    }
+    return false;
+}
+
+static void checkBlit(const char* name, const char* text, int x, int y, unsigned int color) {
+    Framebuffer framebuffer;
+    resizeFramebuffer(framebuffer, TEST_WIDTH, TEST_HEIGHT);
+    for (size_t i = 0; i < framebuffer.pixels.size(); i++) framebuffer.pixels[i] = BACKGROUND;
+
+    TextRun run;
+    prepareTextRun(run, text);
+    blitTextRun(run, framebuffer, x, y, color);
+
+    // A covered pixel is the color blended over the background, as one
+    // blendSpan pixel; everything else is left alone
+    unsigned int covered = BACKGROUND;
+    blendSpan(&covered, 1, premultiplyColor(color), BLEND_ALPHA);
+
+    int wrong = 0, drawn = 0;
+    for (int py = 0; py < TEST_HEIGHT; py++) {
+        for (int px = 0; px < TEST_WIDTH; px++) {
+            bool inside = fontCovers(text, x, y, px, py);
+            unsigned int expected = inside ? covered : BACKGROUND;
+            if (framebufferRow(framebuffer, py)[px] != expected) wrong++;
+            drawn += inside;
+        }
+    }
+    char detail[96];
+    snprintf(detail, sizeof(detail), "%d glyph pixels, %d wrong", drawn, wrong);
+    check(drawn > 0 && wrong == 0, name, detail);
+}
+
+int main() {
+    printf("Software text blit against the 9x15 font bitmaps\n");
+
+    checkBlit("opaque", "Alt=250m @ T-10", 4, 20, 0xFFFFFFFFu);
+    checkBlit("blended", "FUEL 42%", 10, 12, 0x8000C0FFu);
+    checkBlit("left/bottom", "CLIPPED", -13, 2, 0xFF00FF00u);
+    checkBlit("right/top", "CLIPPED", TEST_WIDTH - 30, TEST_HEIGHT - 6, 0xFF0000FFu);
+
+    printf("%s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,213 @@
+#include "text_renderer.h"
+#include "font_9x15.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef __APPLE__
+#include <GLUT/glut.h>
+#else
+#include <GL/glut.h>
+#endif
+
+// ========== TEXT BUFFERS ==========
+void textClear(TextBuffer& buffer) {
+    buffer.length = 0;
+    buffer.text[0] = '\0';
+}
+
+static void textAppendChar(TextBuffer& buffer, char c) {
+    if (buffer.length < TEXT_BUFFER_CAPACITY - 1) {
+        buffer.text[buffer.length++] = c;
+        buffer.text[buffer.length] = '\0';
+    }
+}
+
+void textAppend(TextBuffer& buffer, const char* text) {
+    while (*text) {
+        textAppendChar(buffer, *text++);
+    }
+}
+
+// Digits of 'value' without sign
+static void textAppendUnsigned(TextBuffer& buffer, unsigned long value) {
+    char digits[24];
+    int count = 0;
+    do {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (count > 0) {
+        textAppendChar(buffer, digits[--count]);
+    }
+}
+
+void textAppendInt(TextBuffer& buffer, int value) {
+    long long magnitude = value;
+    if (magnitude < 0) {
+        textAppendChar(buffer, '-');
+        magnitude = -magnitude;
+    }
+    textAppendUnsigned(buffer, (unsigned long)magnitude);
+}
+
+void textAppendFixed(TextBuffer& buffer, float value, int decimals) {
+    unsigned long scale = 1;
+    for (int i = 0; i < decimals; i++) scale *= 10;
+
+    if (value < 0.0f) {
+        textAppendChar(buffer, '-');
+        value = -value;
+    }
+    unsigned long scaled = (unsigned long)(value * scale + 0.5f);
+    textAppendUnsigned(buffer, scaled / scale);
+    if (decimals > 0) {
+        textAppendChar(buffer, '.');
+        unsigned long fraction = scaled % scale;
+        for (unsigned long digit = scale / 10; digit > 0; digit /= 10) {
+            textAppendChar(buffer, (char)('0' + (fraction / digit) % 10));
+        }
+    }
+}
+
+// ========== GLYPH ATLAS ==========
+// Glyphs sit in a grid of FONT_9X15_WIDTH x FONT_9X15_HEIGHT cells, built once
+// on the CPU and shared by both backends
+static unsigned char glyphAtlas[TEXT_ATLAS_HEIGHT][TEXT_ATLAS_WIDTH];
+static bool glyphAtlasBuilt = false;
+static GLuint glyphAtlasTexture = 0;
+
+static void buildGlyphAtlas() {
+    if (glyphAtlasBuilt) return;
+
+    for (int v = 0; v < TEXT_ATLAS_HEIGHT; v++) {
+        for (int u = 0; u < TEXT_ATLAS_WIDTH; u++) {
+            glyphAtlas[v][u] = 0;
+        }
+    }
+
+    for (int cell = 0; cell < FONT_9X15_CHAR_COUNT; cell++) {
+        int cellU = (cell % TEXT_ATLAS_COLUMNS) * FONT_9X15_WIDTH;
+        int cellV = (cell / TEXT_ATLAS_COLUMNS) * FONT_9X15_HEIGHT;
+        for (int row = 0; row < FONT_9X15_HEIGHT; row++) {
+            unsigned short bits = FONT_9X15_ROWS[cell][row];
+            for (int col = 0; col < FONT_9X15_WIDTH; col++) {
+                if (bits & (0x8000 >> col)) {
+                    glyphAtlas[cellV + row][cellU + col] = 255;
+                }
+            }
+        }
+    }
+    glyphAtlasBuilt = true;
+}
+
+static void uploadGlyphAtlas() {
+    if (glyphAtlasTexture != 0) return;
+    buildGlyphAtlas();
+
+    glGenTextures(1, &glyphAtlasTexture);
+    glBindTexture(GL_TEXTURE_2D, glyphAtlasTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, TEXT_ATLAS_WIDTH, TEXT_ATLAS_HEIGHT, 0,
+                 GL_ALPHA, GL_UNSIGNED_BYTE, glyphAtlas);
+}
+
+void initializeTextRendering() {
+    uploadGlyphAtlas();
+}
+
+// ========== TEXT RUNS ==========
+void prepareTextRun(TextRun& run, const char* text) {
+    run.source = text;
+    run.glyphCount = 0;
+
+    float penX = 0.0f;
+    for (const char* c = text; *c && run.glyphCount < TEXT_RUN_CAPACITY; c++) {
+        int cell = (unsigned char)*c - FONT_9X15_FIRST_CHAR;
+        // Spaces and unsupported characters only advance the pen
+        if (cell > 0 && cell < FONT_9X15_CHAR_COUNT) {
+            run.glyphX[run.glyphCount] = penX;
+            run.glyphCell[run.glyphCount] = cell;
+            run.glyphCount++;
+        }
+        penX += FONT_9X15_WIDTH;
+    }
+}
+
+void drawTextRun(const TextRun& run, float x, float y) {
+    if (run.glyphCount == 0) return;
+    uploadGlyphAtlas();
+
+    glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_COLOR_BUFFER_BIT);
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, glyphAtlasTexture);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    glEnable(GL_ALPHA_TEST);
+    glAlphaFunc(GL_GREATER, 0.5f);
+
+    const float cellW = (float)FONT_9X15_WIDTH / TEXT_ATLAS_WIDTH;
+    const float cellH = (float)FONT_9X15_HEIGHT / TEXT_ATLAS_HEIGHT;
+    float bottom = std::floor(y + 0.5f) - FONT_9X15_BASELINE;
+    float top = bottom + FONT_9X15_HEIGHT;
+    float left = std::floor(x + 0.5f);
+
+    glBegin(GL_QUADS);
+    for (int i = 0; i < run.glyphCount; i++) {
+        int cell = run.glyphCell[i];
+        float u0 = (cell % TEXT_ATLAS_COLUMNS) * cellW;
+        float v0 = (cell / TEXT_ATLAS_COLUMNS) * cellH;
+        float x0 = left + run.glyphX[i];
+        float x1 = x0 + FONT_9X15_WIDTH;
+
+        glTexCoord2f(u0, v0);                 glVertex2f(x0, bottom);
+        glTexCoord2f(u0 + cellW, v0);         glVertex2f(x1, bottom);
+        glTexCoord2f(u0 + cellW, v0 + cellH); glVertex2f(x1, top);
+        glTexCoord2f(u0, v0 + cellH);         glVertex2f(x0, top);
+    }
+    glEnd();
+
+    glPopAttrib();
+}
+
+void drawTextString(float x, float y, const char* text) {
+    TextRun run;
+    prepareTextRun(run, text);
+    drawTextRun(run, x, y);
+}
+
+void drawCachedText(float x, float y, TextRun& run, const char* text) {
+    if (run.source != text) {
+        prepareTextRun(run, text);
+    }
+    drawTextRun(run, x, y);
+}
+
+// ========== SOFTWARE BACKEND ==========
+void blitTextRun(const TextRun& run, Framebuffer& framebuffer, int x, int y,
+                 unsigned int color, BlendMode mode) {
+    buildGlyphAtlas();
+    unsigned int premultiplied = premultiplyColor(color);
+
+    int bottom = y - FONT_9X15_BASELINE;
+    int rowBegin = std::max(0, -bottom);
+    int rowEnd = std::min(FONT_9X15_HEIGHT, framebuffer.height - bottom);
+    for (int i = 0; i < run.glyphCount; i++) {
+        int cell = run.glyphCell[i];
+        int cellU = (cell % TEXT_ATLAS_COLUMNS) * FONT_9X15_WIDTH;
+        int cellV = (cell / TEXT_ATLAS_COLUMNS) * FONT_9X15_HEIGHT;
+        int left = x + (int)run.glyphX[i];
+
+        // Each glyph row is a run of atlas coverage bytes
+        int colBegin = std::max(0, -left);
+        int colEnd = std::min(FONT_9X15_WIDTH, framebuffer.width - left);
+        if (colBegin >= colEnd) continue;
+        for (int row = rowBegin; row < rowEnd; row++) {
+            blendSpanCoverage(framebufferRow(framebuffer, bottom + row) + left + colBegin,
+                              &glyphAtlas[cellV + row][cellU + colBegin], colEnd - colBegin,
+                              premultiplied, mode);
+        }
+    }
+}
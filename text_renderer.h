@@ -0,0 +1,57 @@
+// text_renderer.h
+#ifndef TEXT_RENDERER_H
+#define TEXT_RENDERER_H
+
+#include "blend_spans.h"
+#include "constants_config.h"
+#include "framebuffer.h"
+
+// ================== TEXT BUFFERS ==================
+// Fixed-size string builder for HUD labels, so per-frame numbers never
+// touch the heap. Appends past the capacity are truncated.
+struct TextBuffer {
+    char text[TEXT_BUFFER_CAPACITY];
+    int length;
+};
+
+void textClear(TextBuffer& buffer);
+void textAppend(TextBuffer& buffer, const char* text);
+void textAppendInt(TextBuffer& buffer, int value);
+void textAppendFixed(TextBuffer& buffer, float value, int decimals);
+
+// ================== PREPARED TEXT RUNS ==================
+// A string laid out against the glyph atlas once: glyph offsets and atlas
+// cells are ready to emit as one batch. 'source' remembers the string the
+// run was built from so cached runs can rebuild themselves when it changes.
+struct TextRun {
+    const char* source;
+    int glyphCount;
+    float glyphX[TEXT_RUN_CAPACITY];   // Left edge relative to the run origin
+    int glyphCell[TEXT_RUN_CAPACITY];  // Atlas cell (character - first char)
+};
+
+void prepareTextRun(TextRun& run, const char* text);
+
+// ================== GL BACKEND ==================
+// Upload the glyph atlas now (needs a GL context). Call before recording
+// text into a display list, so the upload is not recorded with it.
+void initializeTextRendering();
+
+// Textured quads from the glyph atlas in the current color; (x, y) is the
+// baseline origin like glRasterPos. The atlas is uploaded on first use.
+void drawTextRun(const TextRun& run, float x, float y);
+void drawTextString(float x, float y, const char* text);
+
+// Draw 'text' through 'run', re-preparing it only when 'text' is a
+// different string than last time (intended for literals and constants)
+void drawCachedText(float x, float y, TextRun& run, const char* text);
+
+// ================== SOFTWARE BACKEND ==================
+// Blend a run into 'framebuffer' from the same atlas and with the same
+// placement as drawTextRun: (x, y) is the baseline origin, rows run bottom
+// to top. 'color' is straight RGBA, scaled by the glyph coverage through
+// blendSpanCoverage; pixels outside the framebuffer are clipped.
+void blitTextRun(const TextRun& run, Framebuffer& framebuffer, int x, int y,
+                 unsigned int color, BlendMode mode = BLEND_ALPHA);
+
+#endif
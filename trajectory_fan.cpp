@@ -0,0 +1,168 @@
+#include "trajectory_fan.h"
+#include "simd_lanes.h"
+
+// ========== LANE FLIGHT STEP ==========
+// SoA copy of stepRocketFlight for four candidates at once
+struct FlightLanes {
+    Lanes x, y, velocity, fuel, stage;
+    Lanes launching, stage1Separated, stage2Separated;
+    Lanes ended; // Landed, crashed or at rest
+};
+
+// Integrate masked lanes under constant acceleration. The Runge-Kutta
+// integrators are exact for constant acceleration, so they share the
+// closed form; semi-implicit Euler keeps its own update.
+static inline void integrateLanes(FlightLanes& f, Lanes accel, Lanes mask, float dt, bool exact) {
+    Lanes step = splat(dt);
+    Lanes velocity = add(f.velocity, mul(accel, step));
+    Lanes position;
+    if (exact) {
+        position = add(f.y, mul(mul(add(f.velocity, velocity), splat(0.5f)), step));
+    } else {
+        position = add(f.y, mul(velocity, step));
+    }
+    f.y = select(mask, position, f.y);
+    f.velocity = select(mask, velocity, f.velocity);
+}
+
+static inline void separateLanes(FlightLanes& f, Lanes mask, Lanes& separated,
+                                 float nextStage, const StageSeparationRule& rule) {
+    separated = maskOr(separated, mask);
+    f.stage = select(mask, splat(nextStage), f.stage);
+    f.fuel = select(mask, splat(rule.nextFuel), f.fuel);
+    f.velocity = select(mask, mul(f.velocity, splat(rule.velocityRetention)), f.velocity);
+}
+
+// Lanes where 'rule' separates the stage (poweredSeparation / coastingSeparation)
+static inline Lanes separationRuleLanes(const FlightLanes& f, const StageSeparationRule& rule,
+                                        Lanes altitude, Lanes powered, Lanes coasting) {
+    Lanes normal = maskAnd(maskAnd(greater(altitude, splat(rule.normalAltitude)), less(f.fuel, splat(rule.normalFuel))),
+                           greater(f.velocity, splat(rule.normalVelocity)));
+    Lanes poweredRule = maskOr(normal, maskOr(less(f.fuel, splat(rule.emergencyFuel)),
+                                              greater(altitude, splat(rule.maxAltitude))));
+    return maskOr(maskAnd(powered, poweredRule), maskAnd(coasting, greater(altitude, splat(rule.coastAltitude))));
+}
+
+static void stepFlightLanes(FlightLanes& f, const FlightConditions& conditions, bool exact) {
+    float dt = conditions.step;
+    Lanes zero = splat(0.0f);
+    Lanes active = maskAndNot(equal(zero, zero), f.ended);
+
+    Lanes hasFuel = greater(f.fuel, zero);
+    Lanes powered = maskAnd(maskAnd(f.launching, hasFuel), active);
+    Lanes coasting = maskAndNot(maskAnd(f.launching, active), hasFuel);
+
+    Lanes isStage1 = equal(f.stage, splat(1.0f));
+    Lanes isStage2 = equal(f.stage, splat(2.0f));
+    Lanes thrust = select(isStage1, splat(STAGE_THRUST[0]),
+                          select(isStage2, splat(STAGE_THRUST[1]), splat(STAGE_THRUST[2])));
+
+    f.fuel = select(powered, sub(f.fuel, splat(FUEL_BURN_RATE * dt)), f.fuel);
+
+    // Wind drift (less effect at higher altitudes)
+    Lanes altitude = sub(f.y, splat(150.0f));
+    float windBase = conditions.windSpeed * conditions.windDirection * 0.1f;
+    Lanes windEffect = mul(splat(windBase), sub(splat(1.0f), mul(altitude, splat(1.0f / 1000.0f))));
+    f.x = select(powered, add(f.x, mul(windEffect, splat(dt))), f.x);
+
+    Lanes moving = maskOr(powered, coasting);
+    integrateLanes(f, select(powered, thrust, splat(COAST_ACCELERATION)), moving, dt, exact);
+
+    // Stage separation rules (see poweredSeparation/coastingSeparation)
+    altitude = sub(f.y, splat(150.0f));
+    Lanes pending1 = maskAndNot(isStage1, f.stage1Separated);
+    Lanes pending2 = maskAndNot(isStage2, f.stage2Separated);
+
+    Lanes separate1 = maskAnd(pending1, separationRuleLanes(f, STAGE_SEPARATION_RULES[0], altitude, powered, coasting));
+    Lanes separate2 = maskAnd(pending2, separationRuleLanes(f, STAGE_SEPARATION_RULES[1], altitude, powered, coasting));
+    separateLanes(f, separate1, f.stage1Separated, 2.0f, STAGE_SEPARATION_RULES[0]);
+    separateLanes(f, separate2, f.stage2Separated, 3.0f, STAGE_SEPARATION_RULES[1]);
+
+    // Maximum altitude ends the launch
+    f.launching = maskAndNot(f.launching, maskAnd(powered, greater(f.y, splat(1000.0f))));
+
+    // Falling back
+    Lanes falling = maskAnd(maskAndNot(active, f.launching), greater(f.y, splat(150.0f)));
+    integrateLanes(f, splat(-0.05f), falling, dt, exact);
+
+    Lanes ground = maskAnd(falling, lessEqual(f.y, splat(150.0f)));
+    Lanes landed = maskAndNot(ground, less(f.velocity, splat(-2.0f)));
+    f.y = select(landed, splat(150.0f), f.y);
+    f.velocity = select(landed, zero, f.velocity);
+
+    Lanes resting = maskAndNot(active, maskOr(moving, falling));
+    f.ended = maskOr(f.ended, maskOr(ground, resting));
+}
+
+// ========== FAN PREDICTION ==========
+void predictTrajectoryFan(TrajectoryFan& fan, const RocketFlightState& current,
+                          const FlightConditions& conditions, int candidates) {
+    if (candidates < 1) candidates = 1;
+    if (candidates > TRAJECTORY_FAN_MAX_CANDIDATES) candidates = TRAJECTORY_FAN_MAX_CANDIDATES;
+    fan.candidateCount = candidates;
+
+    // Taps alternate around the current input: +1, -1, +2, -2, ...
+    for (int i = 0; i < candidates; i++) {
+        int magnitude = i / 2 + 1;
+        fan.thrustTaps[i] = (i % 2 == 0) ? magnitude : -magnitude;
+        fan.pointCount[i] = 0;
+    }
+
+    bool exact = conditions.integrator != INTEGRATOR_SEMI_IMPLICIT_EULER;
+
+    for (int group = 0; group < candidates; group += 4) {
+        float x[4], y[4], velocity[4], fuel[4], stage[4];
+        bool launching[4], stage1Separated[4], stage2Separated[4], unused[4];
+
+        for (int lane = 0; lane < 4; lane++) {
+            int c = group + lane;
+            int taps = (c < candidates) ? fan.thrustTaps[c] : 0;
+            x[lane] = current.x;
+            y[lane] = current.y;
+            velocity[lane] = current.velocity + taps * MANUAL_THRUST_STEP;
+            fuel[lane] = current.fuel - (taps > 0 ? taps * MANUAL_THRUST_FUEL : 0.0f);
+            stage[lane] = (float)current.stage;
+            launching[lane] = current.launching;
+            stage1Separated[lane] = current.stage1Separated;
+            stage2Separated[lane] = current.stage2Separated;
+            unused[lane] = c >= candidates;
+        }
+
+        FlightLanes f;
+        f.x = loadLanes(x);
+        f.y = loadLanes(y);
+        f.velocity = loadLanes(velocity);
+        f.fuel = loadLanes(fuel);
+        f.stage = loadLanes(stage);
+        f.launching = maskFrom(launching);
+        f.stage1Separated = maskFrom(stage1Separated);
+        f.stage2Separated = maskFrom(stage2Separated);
+        f.ended = maskFrom(unused);
+
+        for (int tick = 1; tick <= TRAJECTORY_FAN_HORIZON; tick++) {
+            int endedBefore = laneBits(f.ended);
+            stepFlightLanes(f, conditions, exact);
+
+            // Record samples, plus the final point of lanes that just ended
+            int endedNow = laneBits(f.ended) & ~endedBefore;
+            bool sample = (tick % TRAJECTORY_FAN_SAMPLE_INTERVAL) == 0;
+            if (sample || endedNow) {
+                storeLanes(x, f.x);
+                storeLanes(y, f.y);
+                for (int lane = 0; lane < 4 && group + lane < candidates; lane++) {
+                    bool wasActive = !(endedBefore & (1 << lane));
+                    bool justEnded = (endedNow & (1 << lane)) != 0;
+                    int c = group + lane;
+                    if (wasActive && (sample || justEnded) && fan.pointCount[c] < TRAJECTORY_FAN_POINTS) {
+                        fan.x[c][fan.pointCount[c]] = x[lane];
+                        fan.y[c][fan.pointCount[c]] = y[lane];
+                        fan.pointCount[c]++;
+                    }
+                }
+            }
+
+            // Whole group finished: skip the rest of the horizon
+            if (laneBits(f.ended) == 0xF) break;
+        }
+    }
+}
@@ -0,0 +1,25 @@
+// trajectory_fan.h
+#ifndef TRAJECTORY_FAN_H
+#define TRAJECTORY_FAN_H
+
+#include "constants_config.h"
+#include "rocket_physics.h"
+
+// Predicted paths for a spread of manual thrust inputs (arrow key taps).
+// Candidate i starts from the current rocket with thrustTaps[i] presses of
+// UP (positive) or DOWN (negative) applied, then all candidates are flown
+// together, four per SIMD register, with one lane per candidate.
+struct TrajectoryFan {
+    int candidateCount;
+    int thrustTaps[TRAJECTORY_FAN_MAX_CANDIDATES];
+    int pointCount[TRAJECTORY_FAN_MAX_CANDIDATES];
+    float x[TRAJECTORY_FAN_MAX_CANDIDATES][TRAJECTORY_FAN_POINTS];
+    float y[TRAJECTORY_FAN_MAX_CANDIDATES][TRAJECTORY_FAN_POINTS];
+};
+
+// Fill 'fan' with 'candidates' paths (clamped to the supported range) around
+// 'current'. Points are recorded every TRAJECTORY_FAN_SAMPLE_INTERVAL ticks.
+void predictTrajectoryFan(TrajectoryFan& fan, const RocketFlightState& current,
+                          const FlightConditions& conditions, int candidates);
+
+#endif
@@ -0,0 +1,138 @@
+#include "trajectory_history.h"
+#include "graphics_algorithms.h"
+#include <algorithm>
+#include <cmath>
+
+static void resetCone(TrajectoryHistory& history) {
+    history.coneX = 0.0f;
+    history.coneY = 0.0f;
+    history.coneLow = 0.0f;
+    history.coneHigh = 0.0f;
+}
+
+// Angle of (dx, dy) from the cone's reference direction
+static float coneAngle(const TrajectoryHistory& history, float dx, float dy) {
+    return std::atan2(history.coneX * dy - history.coneY * dx, history.coneX * dx + history.coneY * dy);
+}
+
+// Whether the segment from the anchor towards offset (dx, dy) passes
+// within the tolerance of every absorbed point
+static bool insideCone(const TrajectoryHistory& history, float dx, float dy) {
+    if (history.coneX == 0.0f && history.coneY == 0.0f) return true;
+    float angle = coneAngle(history, dx, dy);
+    return angle >= history.coneLow && angle <= history.coneHigh;
+}
+
+// Keep only the directions that pass within the tolerance of the point at
+// offset (dx, dy) from the anchor
+static void narrowCone(TrajectoryHistory& history, float dx, float dy) {
+    float distance = std::sqrt(dx * dx + dy * dy);
+    if (distance <= history.tolerance) return; // Every direction passes close enough
+    float halfWidth = std::asin(history.tolerance / distance);
+    if (history.coneX == 0.0f && history.coneY == 0.0f) {
+        history.coneX = dx / distance;
+        history.coneY = dy / distance;
+        history.coneLow = -halfWidth;
+        history.coneHigh = halfWidth;
+        return;
+    }
+    float angle = coneAngle(history, dx, dy);
+    history.coneLow = std::max(history.coneLow, angle - halfWidth);
+    history.coneHigh = std::min(history.coneHigh, angle + halfWidth);
+}
+
+void clearTrajectoryHistory(TrajectoryHistory& history) {
+    history.count = 0;
+    history.minSpacing = TRAJECTORY_MIN_SPACING;
+    history.tolerance = TRAJECTORY_TOLERANCE;
+    resetCone(history);
+}
+
+// Drop every other interior point and relax the decimation thresholds
+static void compactTrajectoryHistory(TrajectoryHistory& history) {
+    int kept = 1; // Always keep the oldest point
+    for (int i = 2; i < history.count - 1; i += 2) {
+        history.x[kept] = history.x[i];
+        history.y[kept] = history.y[i];
+        kept++;
+    }
+    
+    // Always keep the tip
+    history.x[kept] = history.x[history.count - 1];
+    history.y[kept] = history.y[history.count - 1];
+    history.count = kept + 1;
+    
+    history.minSpacing *= 2.0f;
+    history.tolerance *= 2.0f;
+}
+
+void appendTrajectoryPoint(TrajectoryHistory& history, float x, float y) {
+    if (history.count < 2) {
+        history.x[history.count] = x;
+        history.y[history.count] = y;
+        history.count++;
+        if (history.count == 2) {
+            narrowCone(history, x - history.x[0], y - history.y[0]);
+        }
+        return;
+    }
+    
+    int anchor = history.count - 2;
+    int tip = history.count - 1;
+    float ax = history.x[anchor], ay = history.y[anchor];
+    
+    // Move the tip instead of committing it when it is too close to the
+    // anchor or the segment to (x, y) still passes every absorbed point
+    float dx = x - ax;
+    float dy = y - ay;
+    bool tooClose = dx * dx + dy * dy < history.minSpacing * history.minSpacing;
+    
+    if (tooClose || insideCone(history, dx, dy)) {
+        narrowCone(history, dx, dy);
+        history.x[tip] = x;
+        history.y[tip] = y;
+        return;
+    }
+    
+    // Commit the tip and start a new one
+    if (history.count == TRAJECTORY_HISTORY_CAPACITY) {
+        compactTrajectoryHistory(history);
+    }
+    history.x[history.count] = x;
+    history.y[history.count] = y;
+    history.count++;
+    
+    // The committed tip anchors the new one
+    float tx = history.x[history.count - 2];
+    float ty = history.y[history.count - 2];
+    resetCone(history);
+    narrowCone(history, x - tx, y - ty);
+}
+
+void drawTrajectoryHistory(const TrajectoryHistory& history, float pixelScale, float pixelSpacing) {
+    if (history.count < 2) return;
+    
+    // Minimum world distance between emitted vertices at this zoom
+    float spacing = pixelSpacing / pixelScale;
+    float spacingSquared = spacing * spacing;
+    
+    float lastX = trajectoryPointX(history, 0);
+    float lastY = trajectoryPointY(history, 0);
+    glVertex2f(lastX, lastY);
+    
+    for (int i = 1; i < history.count - 1; i++) {
+        float x = trajectoryPointX(history, i);
+        float y = trajectoryPointY(history, i);
+        float dx = x - lastX;
+        float dy = y - lastY;
+        if (dx * dx + dy * dy < spacingSquared) continue;
+        
+        glVertex2f(x, y);
+        lastX = x;
+        lastY = y;
+    }
+    
+    // The tip is always emitted
+    glVertex2f(trajectoryPointX(history, history.count - 1),
+               trajectoryPointY(history, history.count - 1));
+}
@@ -0,0 +1,44 @@
+// trajectory_history.h
+#ifndef TRAJECTORY_HISTORY_H
+#define TRAJECTORY_HISTORY_H
+
+#include "constants_config.h"
+
+// Flight path history stored in a fixed array, oldest point first.
+// Points are decimated online: the newest point is a floating "tip" that is
+// only committed once it moves far enough from the last committed point
+// (the anchor) and bends away from the straight line. Every point the tip
+// has absorbed narrows a cone of directions from the anchor that pass
+// within 'tolerance' of it; a new point outside the cone commits the tip,
+// so no absorbed point strays further than that from the drawn segment
+// (closer than 'minSpacing' to the anchor, by at most that). When the
+// array fills up every other point is dropped in place and the thresholds
+// are doubled, so the whole ascent fits in bounded memory with amortized
+// O(1) appends.
+struct TrajectoryHistory {
+    float x[TRAJECTORY_HISTORY_CAPACITY];
+    float y[TRAJECTORY_HISTORY_CAPACITY];
+    int count;         // Number of stored points (including the tip)
+    float minSpacing;  // Current minimum distance between committed points
+    float tolerance;   // Current allowed deviation from a straight segment
+    float coneX, coneY;        // Unit direction the cone is measured from (0, 0: no cone yet)
+    float coneLow, coneHigh;   // Allowed directions, radians relative to it
+};
+
+void clearTrajectoryHistory(TrajectoryHistory& history);
+void appendTrajectoryPoint(TrajectoryHistory& history, float x, float y);
+
+// Access the i-th point, oldest first
+inline float trajectoryPointX(const TrajectoryHistory& history, int i) {
+    return history.x[i];
+}
+
+inline float trajectoryPointY(const TrajectoryHistory& history, int i) {
+    return history.y[i];
+}
+
+// Emit the history as a GL line strip, skipping points closer together than
+// 'pixelSpacing' on screen at the given world->pixel scale
+void drawTrajectoryHistory(const TrajectoryHistory& history, float pixelScale, float pixelSpacing);
+
+#endif
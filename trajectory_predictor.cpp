@@ -0,0 +1,104 @@
+#include "trajectory_predictor.h"
+#include <cmath>
+
+void invalidateTrajectoryPrediction(TrajectoryPrediction& prediction) {
+    prediction.head = 0;
+    prediction.count = 0;
+    prediction.ended = false;
+    prediction.valid = false;
+}
+
+static bool sameConditions(const FlightConditions& a, const FlightConditions& b) {
+    return a.windSpeed == b.windSpeed &&
+           a.windDirection == b.windDirection &&
+           a.step == b.step &&
+           a.integrator == b.integrator;
+}
+
+static bool nearlyEqual(float a, float b) {
+    return std::fabs(a - b) <= TRAJECTORY_PREDICTION_TOLERANCE;
+}
+
+// Does the real rocket still follow the predicted state?
+static bool sameFlightState(const RocketFlightState& a, const RocketFlightState& b) {
+    return a.stage == b.stage &&
+           a.launching == b.launching &&
+           a.launched == b.launched &&
+           a.stage1Separated == b.stage1Separated &&
+           a.stage2Separated == b.stage2Separated &&
+           (a.fuel > 0) == (b.fuel > 0) &&
+           nearlyEqual(a.x, b.x) &&
+           nearlyEqual(a.y, b.y) &&
+           nearlyEqual(a.velocity, b.velocity) &&
+           nearlyEqual(a.angle, b.angle) &&
+           nearlyEqual(a.fuel, b.fuel);
+}
+
+// Predict forward from the tip until the buffer is full or the flight ends
+static void extendTrajectoryPrediction(TrajectoryPrediction& prediction) {
+    while (!prediction.ended && prediction.count < TRAJECTORY_PREDICTION_HORIZON) {
+        FlightStepResult result = stepRocketFlight(prediction.tip, prediction.conditions);
+        
+        // A rocket resting on the pad produces no motion to predict
+        if ((result.events & (FLIGHT_PHASE_POWERED | FLIGHT_PHASE_COASTING | FLIGHT_PHASE_FALLING)) == 0) {
+            prediction.ended = true;
+            break;
+        }
+        
+        int index = (prediction.head + prediction.count) % TRAJECTORY_PREDICTION_HORIZON;
+        prediction.points[index] = prediction.tip;
+        prediction.count++;
+        
+        if (flightHasEnded(result.events)) {
+            prediction.ended = true;
+        }
+    }
+}
+
+static void restartTrajectoryPrediction(TrajectoryPrediction& prediction, const RocketFlightState& start,
+                                        const FlightConditions& conditions, unsigned long tick, bool launchPreview) {
+    invalidateTrajectoryPrediction(prediction);
+    prediction.anchor = start;
+    prediction.tip = start;
+    prediction.conditions = conditions;
+    prediction.anchorTick = tick;
+    prediction.launchPreview = launchPreview;
+    prediction.valid = true;
+}
+
+void updateTrajectoryPrediction(TrajectoryPrediction& prediction, const RocketFlightState& current,
+                                const FlightConditions& conditions, unsigned long tick, bool launchPreview) {
+    RocketFlightState start = current;
+    if (launchPreview) {
+        // The rocket is not moving yet, so the preview never advances
+        start.launching = true;
+        tick = prediction.anchorTick;
+    }
+    
+    bool reusable = prediction.valid &&
+                    prediction.launchPreview == launchPreview &&
+                    sameConditions(prediction.conditions, conditions) &&
+                    tick >= prediction.anchorTick;
+    
+    if (reusable) {
+        // Drop the points the simulation has already flown through
+        unsigned long consumed = tick - prediction.anchorTick;
+        if (consumed > 0) {
+            if (consumed > (unsigned long)prediction.count) {
+                reusable = false;
+            } else {
+                prediction.anchor = predictedPoint(prediction, (int)consumed - 1);
+                prediction.head = (prediction.head + (int)consumed) % TRAJECTORY_PREDICTION_HORIZON;
+                prediction.count -= (int)consumed;
+                prediction.anchorTick = tick;
+            }
+        }
+        reusable = reusable && sameFlightState(prediction.anchor, start);
+    }
+    
+    if (!reusable) {
+        restartTrajectoryPrediction(prediction, start, conditions, tick, launchPreview);
+    }
+    
+    extendTrajectoryPrediction(prediction);
+}
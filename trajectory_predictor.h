@@ -0,0 +1,39 @@
+// trajectory_predictor.h
+#ifndef TRAJECTORY_PREDICTOR_H
+#define TRAJECTORY_PREDICTOR_H
+
+#include "constants_config.h"
+#include "rocket_physics.h"
+
+// Predicted flight path, produced by the same stepRocketFlight the live
+// rocket uses. The prediction is kept between frames: as the simulation
+// advances, consumed points are dropped from the front and new ones are
+// appended at the tail. A full recompute only happens when the real rocket
+// stops matching the prediction (stage, angle or fuel changed by input) or
+// the flight conditions change (wind, integrator, step size).
+struct TrajectoryPrediction {
+    RocketFlightState points[TRAJECTORY_PREDICTION_HORIZON]; // Ring buffer, one tick apart
+    int head;                     // Index of the point one tick after 'anchor'
+    int count;                    // Number of predicted points
+    RocketFlightState anchor;     // Real state the prediction starts from
+    RocketFlightState tip;        // State after the last predicted point
+    bool ended;                   // Tip has landed, crashed or come to rest
+    FlightConditions conditions;  // Conditions the prediction was made under
+    unsigned long anchorTick;     // Simulation tick of 'anchor'
+    bool launchPreview;           // Predicting a launch from the pad
+    bool valid;
+};
+
+void invalidateTrajectoryPrediction(TrajectoryPrediction& prediction);
+
+// Bring the prediction in line with 'current' at simulation tick 'tick'.
+// With 'launchPreview' set the rocket is treated as if it launched now.
+void updateTrajectoryPrediction(TrajectoryPrediction& prediction, const RocketFlightState& current,
+                                const FlightConditions& conditions, unsigned long tick, bool launchPreview);
+
+// Access the i-th predicted point, nearest first
+inline const RocketFlightState& predictedPoint(const TrajectoryPrediction& prediction, int i) {
+    return prediction.points[(prediction.head + i) % TRAJECTORY_PREDICTION_HORIZON];
+}
+
+#endif
@@ -3,15 +3,11 @@
 
 #include <vector>
 #include <utility>
+#include "constants_config.h"
 
 // Basic structures
-struct Star {
-    float x, y;
-    float brightness;
-    float twinkleSpeed;
-};
-
 struct SmokeParticle {
+    unsigned int id;  // Keys the particle's random jitter (particle_rng.h)
     float x, y;
     float size;
     float speed;
@@ -47,9 +43,25 @@ struct Meteor {
     float speed;
     float size;
     float trailLength;
-    std::vector<float> trailX, trailY;
+    // Trail stored as a circular buffer, newest point at trailHead
+    float trailX[METEOR_TRAIL_CAPACITY];
+    float trailY[METEOR_TRAIL_CAPACITY];
+    int trailHead;
+    int trailCount;
 };
 
+// Points the trail keeps: trailLength, clamped to what the buffer holds
+inline int meteorTrailLimit(const Meteor& meteor) {
+    int limit = static_cast<int>(meteor.trailLength);
+    if (limit < 0) return 0;
+    return limit < METEOR_TRAIL_CAPACITY ? limit : METEOR_TRAIL_CAPACITY;
+}
+
+// Index of the i-th trail point (0 = newest) in the circular buffer
+inline int meteorTrailIndex(const Meteor& meteor, int i) {
+    return (meteor.trailHead + i) % METEOR_TRAIL_CAPACITY;
+}
+
 struct RocketStage {
     float x, y;
     float velocity;